@@ -211,6 +211,7 @@ void DismantleFacilityState::btnOkClick(Action *)
 						}
 					}
 				}
+				_base->invalidateCapacities();
 				_view->resetSelectedFacility();
 				delete _fac;
 				// Reset the basescape view in case new facilities were created by removing the old one
@@ -23,6 +23,7 @@
 #include "../Mod/RuleBaseFacility.h"
 #include "../Mod/RuleItem.h"
 #include "../Mod/RuleManufacture.h"
+#include "../Mod/TechDependencyGraph.h"
 #include "../Engine/LocalizedText.h"
 #include "../Engine/Options.h"
 #include "../Interface/TextButton.h"
@@ -30,7 +31,6 @@
 #include "../Interface/Text.h"
 #include "../Interface/TextList.h"
 #include "../Savegame/SavedGame.h"
-#include <unordered_map>
 #include <unordered_set>
 
 namespace OpenXcom
@@ -136,20 +136,12 @@ void ManufactureDependenciesTreeState::initList()
 	_lstTopics->clearList();
 
 	// dependency map (item -> vector of items that needs this item)
-	std::unordered_map< std::string, std::vector<std::string> > deps;
-
-	for (auto& manufName : _game->getMod()->getManufactureList())
-	{
-		RuleManufacture *rule = _game->getMod()->getManufacture(manufName);
-		for (auto& pair : rule->getRequiredItems())
-		{
-			deps[pair.first->getType()].push_back(manufName);
-		}
-	}
+	const TechDependencyGraph *graph = _game->getMod()->getTechDependencyGraph();
+	auto deps = [graph](const std::string &item) -> const std::vector<std::string>& { return graph->getItemLinks(item).usedByManufacture; };
 
 	// breadth-first tree search
 	int row = 0;
-	const std::vector<std::string> firstLevel = deps[_selectedItem];
+	const std::vector<std::string> &firstLevel = deps(_selectedItem);
 	std::vector<std::string> secondLevel;
 	std::vector<std::string> thirdLevel;
 	std::vector<std::string> fourthLevel;
@@ -163,17 +155,9 @@ void ManufactureDependenciesTreeState::initList()
 	}
 
 	std::vector<const RuleBaseFacility*> facilitiesLevel;
-	for (auto& facilityType : _game->getMod()->getBaseFacilitiesList())
+	for (auto& facilityType : graph->getItemLinks(_selectedItem).usedByFacilities)
 	{
-		RuleBaseFacility* facilityRule = _game->getMod()->getBaseFacility(facilityType);
-		for (auto& itemRequired : facilityRule->getBuildCostItems())
-		{
-			if (itemRequired.first == _selectedItem)
-			{
-				facilitiesLevel.push_back(facilityRule);
-				break;
-			}
-		}
+		facilitiesLevel.push_back(_game->getMod()->getBaseFacility(facilityType));
 	}
 
 	if (firstLevel.empty() && facilitiesLevel.empty())
@@ -215,7 +199,7 @@ void ManufactureDependenciesTreeState::initList()
 		}
 		++row;
 
-		for (const auto& goDeeper : deps[name])
+		for (const auto& goDeeper : deps(name))
 		{
 			if (alreadyVisited.find(goDeeper) == alreadyVisited.end())
 			{
@@ -252,7 +236,7 @@ void ManufactureDependenciesTreeState::initList()
 		}
 		++row;
 
-		for (const auto& goDeeper : deps[name])
+		for (const auto& goDeeper : deps(name))
 		{
 			if (alreadyVisited.find(goDeeper) == alreadyVisited.end())
 			{
@@ -289,7 +273,7 @@ void ManufactureDependenciesTreeState::initList()
 		}
 		++row;
 
-		for (const auto& goDeeper : deps[name])
+		for (const auto& goDeeper : deps(name))
 		{
 			if (alreadyVisited.find(goDeeper) == alreadyVisited.end())
 			{
@@ -326,7 +310,7 @@ void ManufactureDependenciesTreeState::initList()
 		}
 		++row;
 
-		for (const auto& goDeeper : deps[name])
+		for (const auto& goDeeper : deps(name))
 		{
 			if (alreadyVisited.find(goDeeper) == alreadyVisited.end())
 			{
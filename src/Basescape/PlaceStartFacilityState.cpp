@@ -71,6 +71,7 @@ void PlaceStartFacilityState::viewClick(Action *)
 		fac->setX(_view->getGridX());
 		fac->setY(_view->getGridY());
 		_base->getFacilities()->push_back(fac);
+		_base->invalidateCapacities();
 		if (fac->getRules()->getPlaceSound() != Mod::NO_SOUND)
 		{
 			_game->getMod()->getSound("GEO.CAT", fac->getRules()->getPlaceSound())->play();
@@ -31,6 +31,7 @@
 #include "../Mod/RuleMissionScript.h"
 #include "../Mod/RuleResearch.h"
 #include "../Mod/RuleSoldierTransformation.h"
+#include "../Mod/TechDependencyGraph.h"
 #include "../Engine/LocalizedText.h"
 #include "../Engine/Options.h"
 #include "../Engine/Unicode.h"
@@ -367,161 +368,28 @@ void TechTreeViewerState::initLists()
 		}
 		//
 
-		const std::vector<std::string> &researchList = _game->getMod()->getResearchList();
-		const std::vector<std::string> &manufactureList = _game->getMod()->getManufactureList();
-
 		// 0. common pre-calculation
 		const std::vector<const RuleResearch*>& reqs = rule->getRequirements();
 		const std::vector<const RuleResearch*>& deps = rule->getDependencies();
-		std::vector<std::string> unlockedBy;
-		std::vector<std::string> disabledBy;
-		std::vector<std::string> reenabledBy;
-		std::vector<std::string> getForFreeFrom;
-		std::vector<std::string> lookupOf;
-		std::vector<std::string> requiredByResearch;
-		std::vector<std::string> requiredByManufacture;
-		std::vector<std::string> requiredByFacilities;
-		std::vector<std::string> requiredByItems;
-		std::vector<std::string> requiredByTransformations;
-		std::vector<std::string> requiredByCrafts;
-		std::vector<std::string> leadsTo;
+		const TechResearchLinks& links = _game->getMod()->getTechDependencyGraph()->getResearchLinks(rule->getName());
+		const std::vector<std::string>& unlockedBy = links.unlockedBy;
+		const std::vector<std::string>& disabledBy = links.disabledBy;
+		const std::vector<std::string>& reenabledBy = links.reenabledBy;
+		const std::vector<std::string>& getForFreeFrom = links.getForFreeFrom;
+		const std::vector<std::string>& lookupOf = links.lookupOf;
+		const std::vector<std::string>& requiredByResearch = links.requiredByResearch;
+		const std::vector<std::string>& requiredByManufacture = links.requiredByManufacture;
+		const std::vector<std::string>& requiredByFacilities = links.requiredByFacilities;
+		const std::vector<std::string>& requiredByItems = links.requiredByItems;
+		const std::vector<std::string>& requiredByTransformations = links.requiredByTransformations;
+		const std::vector<std::string>& requiredByCrafts = links.requiredByCrafts;
+		const std::vector<std::string>& leadsTo = links.leadsTo;
 		const std::vector<const RuleResearch*>& unlocks = rule->getUnlocked();
 		const std::vector<const RuleResearch*>& disables = rule->getDisabled();
 		const std::vector<const RuleResearch*>& reenables = rule->getReenabled();
 		const std::vector<const RuleResearch*>& free = rule->getGetOneFree();
 		auto& freeProtected = rule->getGetOneFreeProtected();
 
-		for (auto& j : manufactureList)
-		{
-			RuleManufacture *temp = _game->getMod()->getManufacture(j);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByManufacture.push_back(j);
-				}
-			}
-		}
-
-		for (auto& f : _game->getMod()->getBaseFacilitiesList())
-		{
-			RuleBaseFacility *temp = _game->getMod()->getBaseFacility(f);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule->getName())
-				{
-					requiredByFacilities.push_back(f);
-				}
-			}
-		}
-
-		for (auto& item : _game->getMod()->getItemsList())
-		{
-			RuleItem *temp = _game->getMod()->getItem(item);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByItems.push_back(item);
-				}
-			}
-			for (auto& i : temp->getBuyRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByItems.push_back(item);
-				}
-			}
-		}
-
-		for (auto& transf : _game->getMod()->getSoldierTransformationList())
-		{
-			RuleSoldierTransformation* temp = _game->getMod()->getSoldierTransformation(transf);
-			for (auto& i : temp->getRequiredResearch())
-			{
-				if (i == rule->getName())
-				{
-					requiredByTransformations.push_back(transf);
-				}
-			}
-		}
-
-		for (auto& c : _game->getMod()->getCraftsList())
-		{
-			RuleCraft *temp = _game->getMod()->getCraft(c);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule->getName())
-				{
-					requiredByCrafts.push_back(c);
-				}
-			}
-		}
-
-		for (auto& j : researchList)
-		{
-			RuleResearch *temp = _game->getMod()->getResearch(j);
-			for (auto& i : temp->getUnlocked())
-			{
-				if (i == rule)
-				{
-					unlockedBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getDisabled())
-			{
-				if (i == rule)
-				{
-					disabledBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getReenabled())
-			{
-				if (i == rule)
-				{
-					reenabledBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getGetOneFree())
-			{
-				if (i == rule)
-				{
-					getForFreeFrom.push_back(j);
-				}
-			}
-			for (auto& itMap : temp->getGetOneFreeProtected())
-			{
-				for (auto& i : itMap.second)
-				{
-					if (i == rule)
-					{
-						getForFreeFrom.push_back(j);
-					}
-				}
-			}
-			if (!Mod::isEmptyRuleName(temp->getLookup()))
-			{
-				if (temp->getLookup() == rule->getName())
-				{
-					lookupOf.push_back(j);
-				}
-			}
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByResearch.push_back(j);
-				}
-			}
-			for (auto& i : temp->getDependencies())
-			{
-				if (i == rule)
-				{
-					leadsTo.push_back(j);
-				}
-			}
-		}
-
 		// 1. item required
 		if (rule->needItem())
 		{
@@ -1081,57 +949,28 @@ void TechTreeViewerState::initLists()
 		std::unordered_set<std::string> unlocksMissions, disablesMissions;
 		bool affectsGameProgression = false;
 
-		for (auto& arcScriptId : *_game->getMod()->getArcScriptList())
+		const TechResearchLinks& scriptLinks = _game->getMod()->getTechDependencyGraph()->getResearchLinks(_selectedTopic);
+		for (auto& trigger : scriptLinks.arcScripts)
 		{
-			auto* arcScript = _game->getMod()->getArcScript(arcScriptId, false);
-			if (arcScript)
-			{
-				for (auto& trigger : arcScript->getResearchTriggers())
-				{
-					if (trigger.first == _selectedTopic)
-					{
-						if (trigger.second)
-							unlocksArcs.insert(arcScriptId);
-						else
-							disablesArcs.insert(arcScriptId);
-					}
-				}
-			}
+			if (trigger.second)
+				unlocksArcs.insert(trigger.first);
+			else
+				disablesArcs.insert(trigger.first);
 		}
-		for (auto& eventScriptId : *_game->getMod()->getEventScriptList())
+		for (auto& trigger : scriptLinks.eventScripts)
 		{
-			auto* eventScript = _game->getMod()->getEventScript(eventScriptId, false);
-			if (eventScript)
-			{
-				for (auto& trigger : eventScript->getResearchTriggers())
-				{
-					if (trigger.first == _selectedTopic)
-					{
-						if (eventScript->getAffectsGameProgression()) affectsGameProgression = true; // remember for later
-						if (trigger.second)
-							unlocksEvents.insert(eventScriptId);
-						else
-							disablesEvents.insert(eventScriptId);
-					}
-				}
-			}
+			if (_game->getMod()->getEventScript(trigger.first, false)->getAffectsGameProgression()) affectsGameProgression = true; // remember for later
+			if (trigger.second)
+				unlocksEvents.insert(trigger.first);
+			else
+				disablesEvents.insert(trigger.first);
 		}
-		for (auto& missionScriptId : *_game->getMod()->getMissionScriptList())
+		for (auto& trigger : scriptLinks.missionScripts)
 		{
-			auto* missionScript = _game->getMod()->getMissionScript(missionScriptId, false);
-			if (missionScript)
-			{
-				for (auto& trigger : missionScript->getResearchTriggers())
-				{
-					if (trigger.first == _selectedTopic)
-					{
-						if (trigger.second)
-							unlocksMissions.insert(missionScriptId);
-						else
-							disablesMissions.insert(missionScriptId);
-					}
-				}
-			}
+			if (trigger.second)
+				unlocksMissions.insert(trigger.first);
+			else
+				disablesMissions.insert(trigger.first);
 		}
 		bool showDetails = false;
 		if (Options::isPasswordCorrect() && _game->isAltPressed())
@@ -1631,37 +1470,8 @@ void TechTreeViewerState::initLists()
 		}
 
 		// 4. produced by
-		std::vector<std::string> producedBy;
-		for (auto& j : _game->getMod()->getManufactureList())
-		{
-			RuleManufacture* temp = _game->getMod()->getManufacture(j);
-			bool found = false;
-			for (auto& i : temp->getProducedItems())
-			{
-				if (i.first == rule)
-				{
-					producedBy.push_back(j);
-					found = true;
-					break;
-				}
-			}
-			if (!found)
-			{
-				for (auto& itMap : temp->getRandomProducedItems())
-				{
-					for (auto& i : itMap.second)
-					{
-						if (i.first == rule)
-						{
-							producedBy.push_back(j);
-							found = true;
-							break;
-						}
-					}
-					if (found) break;
-				}
-			}
-		}
+		const TechItemLinks& itemLinks = _game->getMod()->getTechDependencyGraph()->getItemLinks(rule->getType());
+		const std::vector<std::string>& producedBy = itemLinks.producedBy;
 		if (producedBy.size() > 0)
 		{
 			_lstFull->addRow(1, tr("STR_PRODUCED_BY").c_str());
@@ -1686,26 +1496,7 @@ void TechTreeViewerState::initLists()
 		}
 
 		// 5. spawned by
-		std::vector<std::string> spawnedBy;
-		for (auto& j : _game->getMod()->getResearchList())
-		{
-			RuleResearch* temp = _game->getMod()->getResearch(j);
-			if (temp->getSpawnedItem() == rule->getType())
-			{
-				spawnedBy.push_back(j);
-			}
-			else
-			{
-				for (auto& sil : temp->getSpawnedItemList())
-				{
-					if (sil == rule->getType())
-					{
-						spawnedBy.push_back(j);
-						break;
-					}
-				}
-			}
-		}
+		const std::vector<std::string>& spawnedBy = itemLinks.spawnedBy;
 		if (spawnedBy.size() > 0)
 		{
 			_lstFull->addRow(1, tr("STR_SPAWNED_BY").c_str());
@@ -1800,14 +1591,10 @@ void TechTreeViewerState::initLists()
 
 		// 3. produced by
 		std::vector<std::string> producedBy;
-		for (auto& j : _game->getMod()->getManufactureList())
+		const std::string& craftProducedBy = _game->getMod()->getTechDependencyGraph()->getCraftProducedBy(rule->getType());
+		if (!craftProducedBy.empty())
 		{
-			RuleManufacture* temp = _game->getMod()->getManufacture(j);
-			if (temp->getProducedCraft() == rule)
-			{
-				producedBy.push_back(j);
-				break;
-			}
+			producedBy.push_back(craftProducedBy);
 		}
 		if (producedBy.size() > 0)
 		{
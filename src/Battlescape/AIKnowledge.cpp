@@ -0,0 +1,341 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AIKnowledge.h"
+#include <algorithm>
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/SavedBattleGame.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates empty knowledge, built on the first decision.
+ * @param save Pointer to the battle.
+ */
+AIKnowledge::AIKnowledge(SavedBattleGame *save) : _save(save), _cellsX(0), _cellsY(0), _depth(0), _spottingUnit(0)
+{
+}
+
+/**
+ * Checks if a unit may be targeted by a faction: it must be still
+ * standing, on another faction and not ignored by the AI. These are the
+ * checks at the top of AIModule::validTarget that don't change during
+ * a decision.
+ * @param state The unit.
+ * @param faction The faction.
+ * @return True if it is a target.
+ */
+bool AIKnowledge::isTarget(const UnitState &state, int faction)
+{
+	return !state.out && state.faction != faction && (state.faction == FACTION_PLAYER || !state.ignored);
+}
+
+/**
+ * Gets the grid cell a unit stands in.
+ * @param state The unit.
+ * @return Index of the cell.
+ */
+size_t AIKnowledge::getCell(const UnitState &state) const
+{
+	int cx = std::max(0, std::min(_cellsX - 1, state.pos.x / CELL_SIZE));
+	int cy = std::max(0, std::min(_cellsY - 1, state.pos.y / CELL_SIZE));
+	return cy * _cellsX + cx;
+}
+
+/**
+ * Adds a unit still standing to the grid of its faction and to the grid
+ * of all units.
+ * @param state The unit.
+ */
+void AIKnowledge::addToGrid(const UnitState &state)
+{
+	if (state.out)
+	{
+		return;
+	}
+	size_t cell = getCell(state);
+	if (state.faction >= FACTION_PLAYER && state.faction <= FACTION_NEUTRAL)
+	{
+		_cells[state.faction][cell].push_back(state.unit);
+	}
+	_cells[3][cell].push_back(state.unit);
+}
+
+/**
+ * Removes a unit from the grids it was added to.
+ * @param state The unit, as it was added.
+ */
+void AIKnowledge::removeFromGrid(const UnitState &state)
+{
+	if (state.out)
+	{
+		return;
+	}
+	size_t cell = getCell(state);
+	for (int grid = 0; grid < 4; ++grid)
+	{
+		if (grid == 3 || grid == state.faction)
+		{
+			std::vector<BattleUnit*> &units = _cells[grid][cell];
+			auto i = std::find(units.begin(), units.end(), state.unit);
+			if (i != units.end())
+			{
+				*i = units.back();
+				units.pop_back();
+			}
+		}
+	}
+}
+
+/**
+ * Checks if units were added, removed or reordered, or the map
+ * changed size, since the knowledge was last built.
+ * @return True if it needs rebuilding.
+ */
+bool AIKnowledge::isOutdated() const
+{
+	const std::vector<BattleUnit*> &units = *_save->getUnits();
+	if (units.size() != _units.size()
+		|| _cellsX != (_save->getMapSizeX() + CELL_SIZE - 1) / CELL_SIZE + 1
+		|| _cellsY != (_save->getMapSizeY() + CELL_SIZE - 1) / CELL_SIZE + 1)
+	{
+		return true;
+	}
+	for (size_t i = 0; i < units.size(); ++i)
+	{
+		if (_units[i].unit != units[i])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Rebuilds the target list of each faction and the grid
+ * of the units still standing, from the unit list.
+ */
+void AIKnowledge::rebuild()
+{
+	_cellsX = (_save->getMapSizeX() + CELL_SIZE - 1) / CELL_SIZE + 1;
+	_cellsY = (_save->getMapSizeY() + CELL_SIZE - 1) / CELL_SIZE + 1;
+	for (auto &cells : _cells)
+	{
+		cells.assign(_cellsX * _cellsY, std::vector<BattleUnit*>());
+	}
+	for (auto &targets : _targets)
+	{
+		targets.clear();
+	}
+	_units.clear();
+	_unitIndexes.clear();
+	for (auto* bu : *_save->getUnits())
+	{
+		UnitState state = { bu, bu->getPosition(), bu->getFaction(), bu->isOut(), bu->isIgnoredByAI() };
+		_unitIndexes[bu] = _units.size();
+		_units.push_back(state);
+		for (int f = FACTION_PLAYER; f <= FACTION_NEUTRAL; ++f)
+		{
+			if (isTarget(state, f))
+			{
+				_targets[f].push_back(bu);
+			}
+		}
+		addToGrid(state);
+	}
+}
+
+/**
+ * Updates the entries of the units that moved, died, changed sides
+ * or started or stopped being ignored since the last decision.
+ * The target lists stay in unit list order.
+ */
+void AIKnowledge::update()
+{
+	auto byIndex = [this](const BattleUnit *unit, size_t index) { return _unitIndexes.at(unit) < index; };
+	for (size_t i = 0; i < _units.size(); ++i)
+	{
+		UnitState &state = _units[i];
+		BattleUnit *bu = state.unit;
+		UnitState now = { bu, bu->getPosition(), bu->getFaction(), bu->isOut(), bu->isIgnoredByAI() };
+		if (state.pos == now.pos
+			&& state.faction == now.faction
+			&& state.out == now.out
+			&& state.ignored == now.ignored)
+		{
+			continue;
+		}
+		for (int f = FACTION_PLAYER; f <= FACTION_NEUTRAL; ++f)
+		{
+			bool was = isTarget(state, f), is = isTarget(now, f);
+			if (was != is)
+			{
+				std::vector<BattleUnit*> &targets = _targets[f];
+				auto pos = std::lower_bound(targets.begin(), targets.end(), i, byIndex);
+				if (is)
+				{
+					targets.insert(pos, bu);
+				}
+				else if (pos != targets.end() && *pos == bu)
+				{
+					targets.erase(pos);
+				}
+			}
+		}
+		if (state.pos != now.pos || state.faction != now.faction || state.out != now.out)
+		{
+			removeFromGrid(state);
+			addToGrid(now);
+		}
+		state = now;
+	}
+}
+
+/**
+ * Starts a decision: rebuilds the knowledge if units were added or
+ * removed, or else updates the units that changed since the last one,
+ * and forgets the spotting counts, as doors or smoke may have changed
+ * since.
+ */
+void AIKnowledge::begin()
+{
+	if (_depth++ == 0)
+	{
+		if (isOutdated())
+		{
+			rebuild();
+		}
+		else
+		{
+			update();
+		}
+		_spotting.clear();
+		_spottingUnit = 0;
+	}
+}
+
+/**
+ * Forgets the units, so the next decision builds the knowledge from
+ * scratch. Called at the start of each turn.
+ */
+void AIKnowledge::reset()
+{
+	_cellsX = 0;
+	_cellsY = 0;
+	_units.clear();
+	_unitIndexes.clear();
+}
+
+/**
+ * Ends a decision, the knowledge isn't used until the next one starts.
+ */
+void AIKnowledge::end()
+{
+	--_depth;
+}
+
+/**
+ * Gets the units a faction may target: the ones still standing, not on
+ * that faction and not ignored by the AI, in unit list order.
+ * @param faction Faction of the thinking unit.
+ * @return List of units.
+ */
+const std::vector<BattleUnit*> &AIKnowledge::getTargets(UnitFaction faction) const
+{
+	static const std::vector<BattleUnit*> none;
+	if (faction < FACTION_PLAYER || faction > FACTION_NEUTRAL)
+	{
+		return none;
+	}
+	return _targets[faction];
+}
+
+/**
+ * Gets the units still standing in the grid cells around a position;
+ * all units within the distance are included, but not only them.
+ * @param pos Position to look around.
+ * @param radius Distance from the position, in tiles.
+ * @param faction Faction of the units, or FACTION_NONE for all.
+ * @param units List to fill.
+ */
+void AIKnowledge::getUnitsNear(Position pos, int radius, UnitFaction faction, std::vector<BattleUnit*> &units) const
+{
+	units.clear();
+	if (radius < 0 || faction > FACTION_NEUTRAL)
+	{
+		return;
+	}
+	const std::vector<std::vector<BattleUnit*> > &cells = _cells[faction < FACTION_PLAYER ? 3 : faction];
+	int x1 = std::max(0, (pos.x - radius) / CELL_SIZE), x2 = std::min(_cellsX - 1, (pos.x + radius) / CELL_SIZE);
+	int y1 = std::max(0, (pos.y - radius) / CELL_SIZE), y2 = std::min(_cellsY - 1, (pos.y + radius) / CELL_SIZE);
+	for (int y = y1; y <= y2; ++y)
+	{
+		for (int x = x1; x <= x2; ++x)
+		{
+			const std::vector<BattleUnit*> &cell = cells[y * _cellsX + x];
+			units.insert(units.end(), cell.begin(), cell.end());
+		}
+	}
+}
+
+/**
+ * Gets how many enemies spot a position, if the same unit
+ * already asked during this decision.
+ * @param unit The thinking unit.
+ * @param pos Position to check.
+ * @param tally Number of spotters, set if known.
+ * @return True if known.
+ */
+bool AIKnowledge::getSpottingUnits(const BattleUnit *unit, Position pos, int &tally) const
+{
+	if (unit != _spottingUnit || !_save->getTile(pos))
+	{
+		return false;
+	}
+	auto i = _spotting.find(_save->getTileIndex(pos));
+	if (i == _spotting.end())
+	{
+		return false;
+	}
+	tally = i->second;
+	return true;
+}
+
+/**
+ * Remembers how many enemies spot a position, until the decision ends
+ * or another unit asks.
+ * @param unit The thinking unit.
+ * @param pos Position checked.
+ * @param tally Number of spotters.
+ */
+void AIKnowledge::setSpottingUnits(const BattleUnit *unit, Position pos, int tally)
+{
+	if (!_save->getTile(pos))
+	{
+		return;
+	}
+	if (unit != _spottingUnit)
+	{
+		_spotting.clear();
+		_spottingUnit = unit;
+	}
+	_spotting[_save->getTileIndex(pos)] = tally;
+}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <unordered_map>
+#include <vector>
+#include "Position.h"
+#include "../Mod/Unit.h"
+
+namespace OpenXcom
+{
+
+class SavedBattleGame;
+class BattleUnit;
+
+/**
+ * What the AI of each faction knows about the units on the battlefield,
+ * shared by all the AI units instead of each of them scanning every unit
+ * for every decision: the units each faction may target, a coarse grid
+ * of units by position, and the spotting counts worked out by the unit
+ * currently thinking. Only valid while a unit thinks, as nothing moves
+ * then; the units that changed are updated when a decision starts, and
+ * everything is built again at the start of each turn and after loading.
+ */
+class AIKnowledge
+{
+public:
+	/// Side of a grid cell, in tiles.
+	static const int CELL_SIZE = 10;
+	/// Keeps the knowledge valid for the lifetime of the object.
+	class Scope
+	{
+		AIKnowledge *_knowledge;
+	public:
+		/// Starts a decision.
+		Scope(AIKnowledge *knowledge) : _knowledge(knowledge) { if (_knowledge) _knowledge->begin(); }
+		/// Ends the decision.
+		~Scope() { if (_knowledge) _knowledge->end(); }
+		Scope(const Scope&) = delete;
+		Scope &operator=(const Scope&) = delete;
+	};
+private:
+	/// What a unit looked like when the knowledge was built.
+	struct UnitState
+	{
+		BattleUnit *unit;
+		Position pos;
+		UnitFaction faction;
+		bool out, ignored;
+	};
+	SavedBattleGame *_save;
+	std::vector<UnitState> _units;
+	std::unordered_map<const BattleUnit*, size_t> _unitIndexes;
+	std::vector<BattleUnit*> _targets[3];
+	std::vector<std::vector<BattleUnit*> > _cells[4];
+	int _cellsX, _cellsY;
+	int _depth;
+	const BattleUnit *_spottingUnit;
+	std::unordered_map<int, int> _spotting;
+	/// Checks if a unit is a target of a faction.
+	static bool isTarget(const UnitState &state, int faction);
+	/// Gets the grid cell of a unit.
+	size_t getCell(const UnitState &state) const;
+	/// Adds a unit to the grid.
+	void addToGrid(const UnitState &state);
+	/// Removes a unit from the grid.
+	void removeFromGrid(const UnitState &state);
+	/// Checks if units were added, removed or reordered since the last build.
+	bool isOutdated() const;
+	/// Rebuilds the target lists and the grid.
+	void rebuild();
+	/// Updates the units that moved, died or changed sides since the last decision.
+	void update();
+public:
+	/// Creates empty knowledge.
+	AIKnowledge(SavedBattleGame *save);
+	/// Starts a decision, bringing the knowledge up to date.
+	void begin();
+	/// Makes the next decision rebuild the knowledge.
+	void reset();
+	/// Ends a decision.
+	void end();
+	/// Is the knowledge valid right now?
+	bool isFresh() const { return _depth > 0; }
+	/// Gets the units a faction may target, in unit list order.
+	const std::vector<BattleUnit*> &getTargets(UnitFaction faction) const;
+	/// Gets the units of a faction (or of any faction) that may be within a distance of a position.
+	void getUnitsNear(Position pos, int radius, UnitFaction faction, std::vector<BattleUnit*> &units) const;
+	/// Gets how many enemies spot a position, if already worked out for this unit.
+	bool getSpottingUnits(const BattleUnit *unit, Position pos, int &tally) const;
+	/// Remembers how many enemies spot a position.
+	void setSpottingUnits(const BattleUnit *unit, Position pos, int tally);
+};
+
+}
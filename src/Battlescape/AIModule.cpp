@@ -19,6 +19,7 @@
 #include <climits>
 #include <algorithm>
 #include "AIModule.h"
+#include "AIKnowledge.h"
 #include "../Savegame/BattleItem.h"
 #include "../Savegame/Node.h"
 #include "../Savegame/SavedBattleGame.h"
@@ -205,6 +206,8 @@ void AIModule::dont_think(BattleAction *action)
  */
 void AIModule::think(BattleAction *action)
 {
+	// nothing moves while we think, so what the faction knows stays valid until we return
+	AIKnowledge::Scope knowledgeScope(_save->getAIKnowledge());
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
@@ -1090,6 +1093,28 @@ void AIModule::setupEscape()
 	}
 }
 
+/**
+ * Gets the knowledge shared by the AI units, if it's valid right now,
+ * ie. while a unit is thinking.
+ * @return Pointer to the knowledge or null.
+ */
+AIKnowledge *AIModule::getKnowledge() const
+{
+	AIKnowledge *knowledge = _save->getAIKnowledge();
+	return knowledge && knowledge->isFresh() ? knowledge : nullptr;
+}
+
+/**
+ * Gets the units that may pass validTarget(): the faction's target list
+ * while thinking, all the units otherwise. Both are in unit list order.
+ * @return List of units.
+ */
+const std::vector<BattleUnit*> &AIModule::getCandidateTargets() const
+{
+	AIKnowledge *knowledge = getKnowledge();
+	return knowledge ? knowledge->getTargets(_unit->getFaction()) : *_save->getUnits();
+}
+
 /**
  * Counts how many targets, both xcom and civilian are known to this unit
  * @return how many targets are known to us.
@@ -1100,7 +1125,7 @@ int AIModule::countKnownTargets() const
 
 	if (_unit->getFaction() == FACTION_HOSTILE)
 	{
-		for (auto* bu : *_save->getUnits())
+		for (auto* bu : getCandidateTargets())
 		{
 			if (validTarget(bu, true, true))
 			{
@@ -1121,7 +1146,17 @@ int AIModule::getSpottingUnits(const Position& pos) const
 	// if we don't actually occupy the position being checked, we need to do a virtual LOF check.
 	bool checking = pos != _unit->getPosition();
 	int tally = 0;
-	for (auto* bu : *_save->getUnits())
+	AIKnowledge *knowledge = getKnowledge();
+	if (knowledge && knowledge->getSpottingUnits(_unit, pos, tally))
+	{
+		return tally;
+	}
+	std::vector<BattleUnit*> nearby;
+	if (knowledge)
+	{
+		knowledge->getUnitsNear(pos, 20, _targetFaction, nearby);
+	}
+	for (auto* bu : knowledge ? nearby : *_save->getUnits())
 	{
 		if (validTarget(bu, false, false))
 		{
@@ -1146,6 +1181,10 @@ int AIModule::getSpottingUnits(const Position& pos) const
 			}
 		}
 	}
+	if (knowledge)
+	{
+		knowledge->setSpottingUnits(_unit, pos, tally);
+	}
 	return tally;
 }
 
@@ -1160,7 +1199,7 @@ int AIModule::selectNearestTarget()
 	_closestDist= 100;
 	_aggroTarget = 0;
 	Position target;
-	for (auto* bu : *_save->getUnits())
+	for (auto* bu : getCandidateTargets())
 	{
 		if (validTarget(bu, true, _unit->getFaction() == FACTION_HOSTILE) &&
 			_save->getTileEngine()->visible(_unit, bu->getTile()))
@@ -1214,7 +1253,7 @@ int AIModule::selectNearestTargetLeeroy(bool canRun)
 	int tally = 0;
 	_closestDist = 100;
 	_aggroTarget = 0;
-	for (auto* bu : *_save->getUnits())
+	for (auto* bu : getCandidateTargets())
 	{
 		if (validTarget(bu, true, _unit->getFaction() == FACTION_HOSTILE) &&
 			_save->getTileEngine()->visible(_unit, bu->getTile()))
@@ -1957,7 +1996,13 @@ int AIModule::explosiveEfficacy(Position targetPos, BattleUnit *attackingUnit, i
 		++efficacy;
 	}
 
-	for (auto* bu : *_save->getUnits())
+	std::vector<BattleUnit*> nearby;
+	AIKnowledge *knowledge = getKnowledge();
+	if (knowledge)
+	{
+		knowledge->getUnitsNear(targetPos, radius, FACTION_NONE, nearby);
+	}
+	for (auto* bu : knowledge ? nearby : *_save->getUnits())
 	{
 			// don't grenade dead guys
 		if (!bu->isOut() &&
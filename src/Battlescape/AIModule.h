@@ -32,6 +32,7 @@ class BattleUnit;
 struct BattleAction;
 class BattlescapeState;
 class Node;
+class AIKnowledge;
 
 enum AIMode { AI_PATROL, AI_AMBUSH, AI_COMBAT, AI_ESCAPE };
 /**
@@ -92,6 +93,10 @@ public:
 	void setupAttack();
 	/// setup an escape objective.
 	void setupEscape();
+	/// Gets the shared AI knowledge, if valid right now.
+	AIKnowledge *getKnowledge() const;
+	/// Gets the units this unit may target.
+	const std::vector<BattleUnit*> &getCandidateTargets() const;
 	/// count how many xcom/civilian units are known to this unit.
 	int countKnownTargets() const;
 	/// count how many known XCom units are able to see this unit.
@@ -396,7 +396,7 @@ void BattlescapeGame::handleAI(BattleUnit *unit)
 	{
 		if (unit->hasAggroSound() && !_playedAggroSound)
 		{
-			getMod()->getSoundByDepth(_save->getDepth(), unit->getRandomAggroSound())->play(-1, getMap()->getSoundAngle(unit->getPosition()));
+			getMod()->getSoundByDepth(_save->getDepth(), unit->getRandomAggroSound())->playInBattle(getMap()->getSoundAngle(unit->getPosition()));
 			_playedAggroSound = true;
 		}
 	}
@@ -523,7 +523,7 @@ void BattlescapeGame::endTurn()
 	{
 		if (_save->getTileEngine()->closeUfoDoors() && Mod::SLIDING_DOOR_CLOSE != -1)
 		{
-			getMod()->getSoundByDepth(_save->getDepth(), Mod::SLIDING_DOOR_CLOSE)->play(); // ufo door closed
+			getMod()->getSoundByDepth(_save->getDepth(), Mod::SLIDING_DOOR_CLOSE)->playInBattle(); // ufo door closed
 		}
 
 		// if all grenades explode we remove items that expire on that turn too.
@@ -1811,7 +1811,7 @@ void BattlescapeGame::primaryAction(Position pos)
 					std::string error;
 					if (_currentAction.spendTU(&error))
 					{
-						_parentState->getGame()->getMod()->getSoundByDepth(_save->getDepth(), _currentAction.weapon->getRules()->getHitSound())->play(-1, getMap()->getSoundAngle(pos));
+						_parentState->getGame()->getMod()->getSoundByDepth(_save->getDepth(), _currentAction.weapon->getRules()->getHitSound())->playInBattle(getMap()->getSoundAngle(pos));
 						_parentState->getGame()->pushState (new UnitInfoState(targetUnit, _parentState, false, true));
 						cancelCurrentAction();
 					}
@@ -3247,7 +3247,7 @@ void BattlescapeGame::playSound(int sound, const Position &pos)
 {
 	if (sound != Mod::NO_SOUND)
 	{
-		_parentState->getGame()->getMod()->getSoundByDepth(_save->getDepth(), sound)->play(-1, _parentState->getMap()->getSoundAngle(pos));
+		_parentState->getGame()->getMod()->getSoundByDepth(_save->getDepth(), sound)->playInBattle(_parentState->getMap()->getSoundAngle(pos));
 	}
 }
 
@@ -3258,7 +3258,7 @@ void BattlescapeGame::playSound(int sound)
 {
 	if (sound != Mod::NO_SOUND)
 	{
-		_parentState->getGame()->getMod()->getSoundByDepth(_save->getDepth(), sound)->play();
+		_parentState->getGame()->getMod()->getSoundByDepth(_save->getDepth(), sound)->playInBattle();
 	}
 }
 
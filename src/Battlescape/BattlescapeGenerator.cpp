@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <sstream>
+#include <unordered_map>
 #include "BattlescapeGenerator.h"
 #include "TileEngine.h"
 #include "Inventory.h"
@@ -46,6 +47,7 @@
 #include "../Engine/Exception.h"
 #include "../Engine/Logger.h"
 #include "../Mod/MapBlock.h"
+#include "../Mod/MapBlockCache.h"
 #include "../Mod/MapDataSet.h"
 #include "../Mod/RuleUfo.h"
 #include "../Mod/RuleCraft.h"
@@ -2057,18 +2059,15 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 {
 	int sizex, sizey, sizez;
 	int x = xoff, y = yoff, z = zoff;
-	char size[3];
-	unsigned char value[4];
 	std::string filename = "MAPS/" + mapblock->getName() + ".MAP";
 	unsigned int terrainObjectID;
 
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, or get it from the cache
+	auto blockTiles = _mod->getMapBlockCache()->getTiles(mapblock->getName());
 
-	mapFile->read((char*)&size, sizeof(size));
-	sizey = (int)size[0];
-	sizex = (int)size[1];
-	sizez = (int)size[2];
+	sizey = blockTiles->sizeY;
+	sizex = blockTiles->sizeX;
+	sizez = blockTiles->sizeZ;
 
 	mapblock->setSizeZ(sizez);
 
@@ -2118,8 +2117,9 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		throw Exception("Something is wrong in your map definitions, craft/ufo map is too tall?");
 	}
 
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t tile = 0; tile < blockTiles->tiles.size(); tile += 4)
 	{
+		const Uint8 *value = &blockTiles->tiles[tile];
 		for (int part = O_FLOOR; part < O_MAX; ++part)
 		{
 			terrainObjectID = ((unsigned char)value[part]);
@@ -2153,11 +2153,6 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		}
 	}
 
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid MAP file: " + filename);
-	}
-
 	// Add the craft offset to the positions of the items if we're loading a craft map
 	// But don't do so if loading a verticalLevel, since the z offset of the craft is handled by that code
 	if (craft && zoff == 0)
@@ -2321,16 +2316,16 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
  */
 void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int zoff, int segment)
 {
-	unsigned char value[24];
 	std::string filename = "ROUTES/" + mapblock->getName() +".RMP";
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, or get it from the cache
+	auto blockRoutes = _mod->getMapBlockCache()->getRoutes(mapblock->getName());
 
 	size_t nodeOffset = _save->getNodes()->size();
 	std::vector<int> badNodes;
 	int nodesAdded = 0;
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t record = 0; record < blockRoutes->nodes.size(); record += 24)
 	{
+		const Uint8 *value = &blockRoutes->nodes[record];
 		int pos_x = value[1];
 		int pos_y = value[0];
 		int pos_z = value[2];
@@ -2397,11 +2392,6 @@ void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int z
 			nodeCounter--;
 		}
 	}
-
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid RMP file: " + filename);
-	}
 }
 
 /**
@@ -2759,6 +2749,13 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 
 	init(true);
 
+	// stop reading ahead however the generation ends, a broken map script throws
+	struct PrefetchGuard
+	{
+		~PrefetchGuard() { FileMap::clearPrefetched(); }
+	} prefetchGuard;
+	prefetchMapFiles(script);
+
 	MapBlock* craftMap = 0;
 	std::vector<MapBlock*> ufoMaps;
 
@@ -3323,6 +3320,71 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 	}
 }
 
+/**
+ * Starts reading the terrain MCD/PCK/TAB files and the MAP/RMP files
+ * of every block the mission may use on background threads, so the files
+ * are already in memory (or on their way) when the map script asks for them.
+ * @param script The map script of the mission.
+ */
+void BattlescapeGenerator::prefetchMapFiles(const std::vector<MapScript*> *script)
+{
+	std::vector<RuleTerrain*> terrains;
+	auto addTerrain = [&](RuleTerrain *terrain)
+	{
+		if (terrain && std::find(terrains.begin(), terrains.end(), terrain) == terrains.end())
+		{
+			terrains.push_back(terrain);
+		}
+	};
+	addTerrain(_terrain);
+	if (script)
+	{
+		for (const auto* command : *script)
+		{
+			for (const auto& name : command->getRandomAlternateTerrain())
+			{
+				addTerrain(_game->getMod()->getTerrain(name));
+			}
+		}
+	}
+	if (_ufo)
+	{
+		addTerrain(_ufo->getRules()->getBattlescapeTerrainData());
+	}
+
+	std::vector<std::string> files;
+	for (auto* terrain : terrains)
+	{
+		for (const auto* mds : *terrain->getMapDataSets())
+		{
+			if (!mds->isLoaded())
+			{
+				files.push_back("TERRAIN/" + mds->getName() + ".MCD");
+				files.push_back("TERRAIN/" + mds->getName() + ".PCK");
+				files.push_back("TERRAIN/" + mds->getName() + ".TAB");
+			}
+		}
+	}
+	// the craft's terrain data depends on its skin, only its blocks are known yet
+	if (_craftRules)
+	{
+		addTerrain(_craftRules->getBattlescapeTerrainData());
+	}
+	for (auto* terrain : terrains)
+	{
+		for (const auto* block : *terrain->getMapBlocks())
+		{
+			if (_mod->getMapBlockCache()->hasBlock(block->getName()))
+			{
+				continue;
+			}
+			files.push_back("MAPS/" + block->getName() + ".MAP");
+			files.push_back("ROUTES/" + block->getName() + ".RMP");
+		}
+	}
+	FileMap::prefetch(files);
+}
+
 /**
  * Generates a map based on the base's layout.
  * this doesn't drill or fill with dirt, the script must do that.
@@ -3964,6 +4026,36 @@ void BattlescapeGenerator::attachNodeLinks()
 		}
 	}
 
+	// Index the nodes by segment and by map block and level, in node order,
+	// so each link only looks at the nodes it can connect to
+	std::unordered_map<int, std::vector<Node*> > nodesBySegment;
+	std::unordered_map<int, std::vector<Node*> > nodesByBlock;
+	auto blockKey = [](int blockX, int blockY, int z) { return (z * 256 + blockY) * 256 + blockX; };
+	for (auto* node : *_save->getNodes())
+	{
+		if (node->isDummy())
+		{
+			continue;
+		}
+		nodesBySegment[node->getSegment()].push_back(node);
+		nodesByBlock[blockKey(node->getPosition().x / 10, node->getPosition().y / 10, node->getPosition().z)].push_back(node);
+	}
+	static const std::vector<Node*> noNodes;
+	auto getNodesBySegment = [&](int segment) -> const std::vector<Node*>&
+	{
+		auto it = nodesBySegment.find(segment);
+		return it != nodesBySegment.end() ? it->second : noNodes;
+	};
+	auto getNodesByBlock = [&](int blockX, int blockY, int z) -> const std::vector<Node*>&
+	{
+		if (blockX < 0 || blockY < 0 || z < 0 || blockX >= 256 || blockY >= 256)
+		{
+			return noNodes;
+		}
+		auto it = nodesByBlock.find(blockKey(blockX, blockY, z));
+		return it != nodesByBlock.end() ? it->second : noNodes;
+	};
+
 	// First pass is original code, connects all ground-level maps
 	for (std::vector<Node*>::iterator i = _save->getNodes()->begin(); i != _save->getNodes()->end(); ++i)
 	{
@@ -4010,21 +4102,15 @@ void BattlescapeGenerator::attachNodeLinks()
 			{
 				if (*j == neighbourDirections[n])
 				{
-					for (std::vector<Node*>::iterator k = _save->getNodes()->begin(); k != _save->getNodes()->end(); ++k)
+					const std::vector<Node*> &neighbours = getNodesBySegment(neighbourSegments[n]);
+					for (std::vector<Node*>::const_iterator k = neighbours.begin(); k != neighbours.end(); ++k)
 					{
-						if ((*k)->isDummy())
-						{
-							continue;
-						}
-						if ((*k)->getSegment() == neighbourSegments[n])
+						for (std::vector<int>::iterator l = (*k)->getNodeLinks()->begin(); l != (*k)->getNodeLinks()->end(); ++l )
 						{
-							for (std::vector<int>::iterator l = (*k)->getNodeLinks()->begin(); l != (*k)->getNodeLinks()->end(); ++l )
+							if (*l == neighbourDirectionsInverted[n])
 							{
-								if (*l == neighbourDirectionsInverted[n])
-								{
-									*l = node->getID();
-									*j = (*k)->getID();
-								}
+								*l = node->getID();
+								*j = (*k)->getID();
 							}
 						}
 					}
@@ -4114,14 +4200,11 @@ void BattlescapeGenerator::attachNodeLinks()
 			linkDirection = std::find(node->getNodeLinks()->begin(), node->getNodeLinks()->end(), (*j).first);
 			if (linkDirection != node->getNodeLinks()->end() || (*j).first == -1 || (*j).first == -6)
 			{
-				for (std::vector<Node*>::iterator k = _save->getNodes()->begin(); k != _save->getNodes()->end(); ++k)
+				const std::vector<int> &direction = (*j).second;
+				const std::vector<Node*> &neighbours = getNodesByBlock(nodeX + direction[0], nodeY + direction[1], nodeZ + direction[2]);
+				for (std::vector<Node*>::const_iterator k = neighbours.begin(); k != neighbours.end(); ++k)
 				{
-					if ((*k)->isDummy())
-					{
-						continue;
-					}
-
-					std::vector<int> currentDirection = (*j).second;
+					const std::vector<int> &currentDirection = (*j).second;
 					int linkX = (*k)->getPosition().x / 10 - currentDirection[0];
 					int linkY = (*k)->getPosition().y / 10 - currentDirection[1];
 					int linkZ = (*k)->getPosition().z - currentDirection[2];
@@ -107,6 +107,8 @@ private:
 	/// Places an item on a soldier based on equipment layout.
 	bool placeItemByLayout(BattleItem *item, const std::vector<BattleItem*> &itemList);
 	void reloadFixedWeaponsByLayout();
+	/// Starts reading the map files of the mission in the background.
+	void prefetchMapFiles(const std::vector<MapScript*> *script);
 	/// Loads an XCom MAP file.
 	int loadMAP(MapBlock *mapblock, int xoff, int yoff, int zoff, RuleTerrain *terrain, int objectIDOffset, bool discovered = false, bool craft = false, int ufoIndex = -1);
 	/// Loads an XCom RMP file.
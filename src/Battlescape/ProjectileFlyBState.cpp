@@ -483,7 +483,7 @@ bool ProjectileFlyBState::createNewProjectile()
 				_parent->getTileEngine()->calculateLighting(LL_UNITS, _unit->getPosition());
 				_parent->getTileEngine()->calculateFOV(_unit->getPosition(), _action.weapon->getGlowRange(), false);
 			}
-			_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::ITEM_THROW)->play(-1, _parent->getMap()->getSoundAngle(_unit->getPosition()));
+			_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::ITEM_THROW)->playInBattle(_parent->getMap()->getSoundAngle(_unit->getPosition()));
 			if (!Mod::EXTENDED_EXPERIENCE_AWARD_SYSTEM)
 			{
 				// vanilla compatibility (throwing anything anywhere gives throwing exp)
@@ -511,11 +511,11 @@ bool ProjectileFlyBState::createNewProjectile()
 			// and we have a lift-off
 			if (_ammo->getRules()->getFireSound() != Mod::NO_SOUND)
 			{
-				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _ammo->getRules()->getFireSound())->play(-1, _parent->getMap()->getSoundAngle(_unit->getPosition()));
+				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _ammo->getRules()->getFireSound())->playInBattle(_parent->getMap()->getSoundAngle(_unit->getPosition()));
 			}
 			else if (_action.weapon->getRules()->getFireSound() != Mod::NO_SOUND)
 			{
-				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _action.weapon->getRules()->getFireSound())->play(-1, _parent->getMap()->getSoundAngle(_unit->getPosition()));
+				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _action.weapon->getRules()->getFireSound())->playInBattle(_parent->getMap()->getSoundAngle(_unit->getPosition()));
 			}
 			if (_action.type != BA_LAUNCH)
 			{
@@ -553,11 +553,11 @@ bool ProjectileFlyBState::createNewProjectile()
 			// and we have a lift-off
 			if (_ammo->getRules()->getFireSound() != Mod::NO_SOUND)
 			{
-				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _ammo->getRules()->getFireSound())->play(-1, _parent->getMap()->getSoundAngle(projectile->getOrigin()));
+				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _ammo->getRules()->getFireSound())->playInBattle(_parent->getMap()->getSoundAngle(projectile->getOrigin()));
 			}
 			else if (_action.weapon->getRules()->getFireSound() != Mod::NO_SOUND)
 			{
-				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _action.weapon->getRules()->getFireSound())->play(-1, _parent->getMap()->getSoundAngle(projectile->getOrigin()));
+				_parent->getMod()->getSoundByDepth(_parent->getDepth(), _action.weapon->getRules()->getFireSound())->playInBattle(_parent->getMap()->getSoundAngle(projectile->getOrigin()));
 			}
 			if (_action.type != BA_LAUNCH)
 			{
@@ -687,7 +687,7 @@ void ProjectileFlyBState::think()
 					pos.x--;
 				}
 
-				_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::ITEM_DROP)->play(-1, _parent->getMap()->getSoundAngle(pos));
+				_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::ITEM_DROP)->playInBattle(_parent->getMap()->getSoundAngle(pos));
 				const RuleItem *ruleItem = _action.weapon->getRules();
 				if (_action.weapon->fuseThrowEvent())
 				{
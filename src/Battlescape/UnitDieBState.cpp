@@ -332,7 +332,7 @@ void UnitDieBState::playDeathSound()
 		int i = sounds[RNG::generate(0, sounds.size() - 1)];
 		if (i >= 0)
 		{
-			_parent->getMod()->getSoundByDepth(_parent->getDepth(), i)->play(-1, _parent->getMap()->getSoundAngle(_unit->getPosition()));
+			_parent->getMod()->getSoundByDepth(_parent->getDepth(), i)->playInBattle(_parent->getMap()->getSoundAngle(_unit->getPosition()));
 		}
 	}
 }
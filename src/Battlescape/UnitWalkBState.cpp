@@ -344,11 +344,11 @@ void UnitWalkBState::think()
 				}
 				if (door == 0)
 				{
-					_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::DOOR_OPEN)->play(-1, _parent->getMap()->getSoundAngle(_unit->getPosition())); // normal door
+					_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::DOOR_OPEN)->playInBattle(_parent->getMap()->getSoundAngle(_unit->getPosition())); // normal door
 				}
 				if (door == 1)
 				{
-					_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::SLIDING_DOOR_OPEN)->play(-1, _parent->getMap()->getSoundAngle(_unit->getPosition())); // ufo door
+					_parent->getMod()->getSoundByDepth(_parent->getDepth(), Mod::SLIDING_DOOR_OPEN)->playInBattle(_parent->getMap()->getSoundAngle(_unit->getPosition())); // ufo door
 					return; // don't start walking yet, wait for the ufo door to open
 				}
 			}
@@ -585,7 +585,7 @@ void UnitWalkBState::playMovementSound()
 	);
 	if (sound >= 0)
 	{
-		_parent->getMod()->getSoundByDepth(_parent->getDepth(), sound)->play(-1, _parent->getMap()->getSoundAngle(_unit->getPosition()));
+		_parent->getMod()->getSoundByDepth(_parent->getDepth(), sound)->playInBattle(_parent->getMap()->getSoundAngle(_unit->getPosition()));
 	}
 }
 
@@ -1042,16 +1042,32 @@ static void OPL_UnLockTable(void)
 /*		YM3812 local section                                                   */
 /*******************************************************************************/
 
+/* ---------- check if a channel is silent ----------- */
+/* a channel with both slots at the end of the release doesn't change */
+/* anymore and adds nothing to the output until a key on */
+INLINE int OPL_CH_SILENT( OPL_CH *CH )
+{
+	return CH->SLOT[SLOT1].evc == EG_OFF && CH->SLOT[SLOT1].evs == 0 && CH->SLOT[SLOT1].eve > EG_OFF &&
+		CH->SLOT[SLOT2].evc == EG_OFF && CH->SLOT[SLOT2].evs == 0 && CH->SLOT[SLOT2].eve > EG_OFF &&
+		CH->op1_out[0] == 0 && CH->op1_out[1] == 0;
+}
+
+/* samples rendered at once */
+#define OPL_BLOCK 256
+
 /* ---------- update one of chip ----------- */
+/* renders blocks of samples channel by channel, */
+/* the output is the same as rendering sample by sample */
 void YM3812UpdateOne(FM_OPL *OPL, INT16 *buffer, int length, int stripe, float volume)
 {
-    int i;
+	int i, j, n;
 	int data;
 	OPLSAMPLE *buf = buffer;
 	UINT32 amsCnt  = OPL->amsCnt;
 	UINT32 vibCnt  = OPL->vibCnt;
 	UINT8 rythm = OPL->rythm&0x20;
 	OPL_CH *CH,*R_CH;
+	INT32 mix[OPL_BLOCK], ams_block[OPL_BLOCK], vib_block[OPL_BLOCK];
 
 	if( (void *)OPL != cur_chip ){
 		cur_chip = (void *)OPL;
@@ -1070,24 +1086,50 @@ void YM3812UpdateOne(FM_OPL *OPL, INT16 *buffer, int length, int stripe, float v
 		vib_table = OPL->vib_table;
 	}
 	R_CH = rythm ? &S_CH[6] : E_CH;
-    for( i=0; i < length ; i+=stripe )
+	for( i=0; i < length ; i+=n*stripe )
 	{
-		/*            channel A         channel B         channel C      */
+		n = (length - i + stripe - 1) / stripe;
+		if( n > OPL_BLOCK ) n = OPL_BLOCK;
 		/* LFO */
-		ams = ams_table[(amsCnt+=amsIncr)>>AMS_SHIFT];
-		vib = vib_table[(vibCnt+=vibIncr)>>VIB_SHIFT];
-		outd[0] = 0;
+		for( j=0; j < n ; j++ )
+		{
+			ams_block[j] = ams_table[(amsCnt+=amsIncr)>>AMS_SHIFT];
+			vib_block[j] = vib_table[(vibCnt+=vibIncr)>>VIB_SHIFT];
+			mix[j] = 0;
+		}
 		/* FM part */
 		for(CH=S_CH ; CH < R_CH ; CH++)
-			OPL_CALC_CH(CH);
+		{
+			if( OPL_CH_SILENT(CH) ) continue;
+			for( j=0; j < n ; j++ )
+			{
+				ams = ams_block[j];
+				vib = vib_block[j];
+				outd[0] = 0;
+				OPL_CALC_CH(CH);
+				mix[j] += outd[0];
+			}
+		}
 		/* Rythm part */
 		if(rythm)
-			OPL_CALC_RH(S_CH);
-		outd[0] *= volume;
-		/* limit check */
-		data = Limit( outd[0] , OPL_MAXOUT, OPL_MINOUT );
-		/* store to sound buffer */
-		buf[i] = data >> OPL_OUTSB;
+		{
+			for( j=0; j < n ; j++ )
+			{
+				ams = ams_block[j];
+				vib = vib_block[j];
+				outd[0] = 0;
+				OPL_CALC_RH(S_CH);
+				mix[j] += outd[0];
+			}
+		}
+		for( j=0; j < n ; j++ )
+		{
+			mix[j] *= volume;
+			/* limit check */
+			data = Limit( mix[j] , OPL_MAXOUT, OPL_MINOUT );
+			/* store to sound buffer */
+			buf[i + j*stripe] = data >> OPL_OUTSB;
+		}
 	}
 
 	OPL->amsCnt = amsCnt;
@@ -18,6 +18,7 @@
  */
 #include "AdlibMusic.h"
 #include <algorithm>
+#include <SDL_thread.h>
 #include "Options.h"
 #include "Logger.h"
 #include "Game.h"
@@ -34,12 +35,33 @@ namespace OpenXcom
 int AdlibMusic::delay = 0;
 int AdlibMusic::rate = 0;
 std::map<int, int> AdlibMusic::delayRates;
+std::atomic<const AdlibMusic*> AdlibMusic::current(nullptr);
+SDL_Thread *AdlibMusic::renderThread = 0;
+std::atomic<bool> AdlibMusic::stopRenderThread(false);
+std::atomic<size_t> AdlibMusic::cacheBytes(0);
+int AdlibMusic::fadeLeft = 0;
+int AdlibMusic::fadeTotal = 0;
+
+namespace
+{
+
+/// Samples (both channels) in a cached chunk.
+const size_t CHUNK_SAMPLES = 2048;
+/// Bytes in a cached chunk.
+const size_t CHUNK_BYTES = CHUNK_SAMPLES * sizeof(Sint16);
+/// Don't bother caching with less room than that many chunks.
+const size_t MIN_CHUNKS = 64;
+/// Seconds of the release tail kept after a track ends.
+const int TAIL_SECONDS = 1;
+
+}
 
 /**
  * Initializes a new music track.
  * @param volume Music volume modifier (1.0 = 100%).
  */
-AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume)
+AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume),
+	_cached(0), _cacheState(ADLIB_CACHE_NONE), _cachePos(0), _cacheLoop(0), _cacheReserved(0)
 {
 	rate = Options::audioSampleRate;
 	if (!opl[0])
@@ -68,6 +90,13 @@ AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volu
  */
 AdlibMusic::~AdlibMusic()
 {
+	if (current == this)
+	{
+		// unhook the player before the cache goes, the audio thread may be copying from it
+		stop();
+		current = nullptr;
+	}
+	clearCache();
 	if (opl[0])
 	{
 		stop();
@@ -113,31 +142,54 @@ void AdlibMusic::play(int) const
 	if (!Options::mute)
 	{
 		stop();
-		func_setup_music((unsigned char*)_data, _size);
-		func_set_music_volume(127 * _volume);
+		current = this;
+		fadeLeft = 0;
+		fadeTotal = 0;
+		_cachePos = 0;
+		if (Options::oxceAdlibMusicCache > 0 && _cacheState != ADLIB_CACHE_COMPLETE)
+		{
+			clearCache();
+			size_t budget = (size_t)Options::oxceAdlibMusicCache * 1024 * 1024;
+			size_t chunks = budget > cacheBytes ? (budget - cacheBytes) / CHUNK_BYTES : 0;
+			if (chunks >= MIN_CHUNKS && opl[0] && opl[1])
+			{
+				// reserve the room now, the chunks must not move while the player reads them
+				_cache.reserve(chunks);
+				_cacheReserved = chunks * CHUNK_BYTES;
+				cacheBytes += _cacheReserved;
+				func_setup_music((unsigned char*)_data, _size);
+				func_set_music_volume(127 * _volume);
+				_cacheState = ADLIB_CACHE_RENDERING;
+				// the first chunk right away, so the music starts without waiting for the thread
+				renderChunk();
+				stopRenderThread = false;
+				renderThread = SDL_CreateThread(renderer, (void*)this);
+				if (!renderThread)
+				{
+					// play the rest as usual
+					_cacheState = ADLIB_CACHE_PARTIAL;
+				}
+			}
+		}
+		if (_cacheState == ADLIB_CACHE_NONE)
+		{
+			func_setup_music((unsigned char*)_data, _size);
+			func_set_music_volume(127 * _volume);
+		}
 		Mix_HookMusic(player, (void*)this);
 	}
 #endif
 }
 
 /**
- * Custom audio player.
- * @param udata User data to send to the player.
+ * Renders music with the two YM3812 emulators,
+ * advancing the player by one tick at a time.
  * @param stream Raw audio to output.
  * @param len Length of audio to output.
+ * @param volume Volume of the output.
  */
-void AdlibMusic::player(void *udata, Uint8 *stream, int len)
+void AdlibMusic::render(Uint8 *stream, int len, float volume)
 {
-#ifndef __NO_MUSIC
-	// Check SDL volume for Background Mute functionality
-	if (Options::musicVolume == 0 || Mix_VolumeMusic(-1) == 0)
-		return;
-	if (Options::musicAlwaysLoop && !func_is_music_playing())
-	{
-		AdlibMusic *music = (AdlibMusic*)udata;
-		music->play();
-		return;
-	}
 	while (len != 0)
 	{
 		if (!opl[0] || !opl[1])
@@ -145,7 +197,6 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 		int i = std::min(delay, len);
 		if (i)
 		{
-			float volume = Game::volumeExponent(Options::musicVolume);
 			YM3812UpdateOne(opl[0], (INT16*)stream, i / 2, 2, volume);
 			YM3812UpdateOne(opl[1], ((INT16*)stream) + 1, i / 2, 2, volume);
 			stream += i;
@@ -158,6 +209,216 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 
 		delay = delayRates[rate];
 	}
+}
+
+/**
+ * Background thread rendering the current track to its cache
+ * at full volume, plus the release tail after the track ends.
+ * Owns the emulators and the player until it returns.
+ * @param data Pointer to the track.
+ * @return Always 0.
+ */
+int AdlibMusic::renderer(void *data)
+{
+	const AdlibMusic *music = (const AdlibMusic*)data;
+	int tail = -1;
+	while (!stopRenderThread)
+	{
+		if (!music->renderChunk())
+		{
+			// out of room, the player takes over from here
+			music->_cacheState = ADLIB_CACHE_PARTIAL;
+			return 0;
+		}
+		if (tail < 0 && !func_is_music_playing())
+		{
+			music->_cacheLoop = music->_cached;
+			tail = TAIL_SECONDS * rate * 2 / CHUNK_SAMPLES;
+		}
+		if (tail >= 0 && tail-- == 0)
+		{
+			// give back the room we didn't need
+			size_t unused = music->_cacheReserved - music->_cache.size() * CHUNK_BYTES;
+			cacheBytes -= unused;
+			music->_cacheReserved -= unused;
+			music->_cacheState = ADLIB_CACHE_COMPLETE;
+			return 0;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Renders the next chunk of the track to the cache.
+ * @return False if the cache is full.
+ */
+bool AdlibMusic::renderChunk() const
+{
+	if (_cache.size() == _cache.capacity())
+	{
+		return false;
+	}
+	std::vector<Sint16> chunk(CHUNK_SAMPLES);
+	render((Uint8*)&chunk[0], CHUNK_BYTES, 1.0f);
+	_cache.push_back(std::move(chunk));
+	_cached += CHUNK_SAMPLES;
+	return true;
+}
+
+/**
+ * Copies the track from the cache, applying the volume.
+ * If the cache ran out of room, carries on rendering
+ * where the background thread stopped.
+ * @param stream Raw audio to output.
+ * @param samples Samples (both channels) to output.
+ * @param volume Volume of the output.
+ */
+void AdlibMusic::playCached(Sint16 *stream, int samples, float volume) const
+{
+	while (samples > 0)
+	{
+		if (fadeTotal > 0 && fadeLeft <= 0)
+		{
+			return;
+		}
+		size_t cached = _cached;
+		if (_cachePos >= cached)
+		{
+			if (_cacheState == ADLIB_CACHE_PARTIAL)
+			{
+				if (Options::musicAlwaysLoop && !func_is_music_playing())
+				{
+					func_setup_music((unsigned char*)_data, _size);
+					func_set_music_volume(127 * _volume);
+				}
+				render((Uint8*)stream, samples * sizeof(Sint16), volume * getFadeVolume());
+			}
+			// otherwise the track is over, or the thread is late
+			return;
+		}
+		if (_cacheState == ADLIB_CACHE_COMPLETE && Options::musicAlwaysLoop && _cacheLoop > 0 && _cachePos >= _cacheLoop)
+		{
+			_cachePos = 0;
+			continue;
+		}
+		size_t offset = _cachePos % CHUNK_SAMPLES;
+		size_t n = std::min(std::min(cached - _cachePos, CHUNK_SAMPLES - offset), (size_t)samples);
+		if (_cacheState == ADLIB_CACHE_COMPLETE && Options::musicAlwaysLoop && _cacheLoop > 0)
+		{
+			n = std::min(n, _cacheLoop - _cachePos);
+		}
+		const Sint16 *src = &_cache[_cachePos / CHUNK_SAMPLES][offset];
+		float v = volume * getFadeVolume();
+		for (size_t i = 0; i < n; ++i)
+		{
+			stream[i] = (Sint16)(src[i] * v);
+		}
+		stream += n;
+		samples -= n;
+		_cachePos += n;
+		if (fadeTotal > 0)
+		{
+			fadeLeft -= n;
+		}
+	}
+}
+
+/**
+ * Frees the cached track and gives back its room.
+ */
+void AdlibMusic::clearCache() const
+{
+	std::vector< std::vector<Sint16> >().swap(_cache);
+	cacheBytes -= _cacheReserved;
+	_cacheReserved = 0;
+	_cached = 0;
+	_cachePos = 0;
+	_cacheLoop = 0;
+	_cacheState = ADLIB_CACHE_NONE;
+}
+
+/**
+ * Gets the volume of the fade out of a cached track.
+ * @return Volume (1.0 = 100%).
+ */
+float AdlibMusic::getFadeVolume()
+{
+	if (fadeTotal <= 0)
+	{
+		return 1.0f;
+	}
+	return std::max(0, fadeLeft) / (float)fadeTotal;
+}
+
+/**
+ * Stops the background thread rendering a track to the cache,
+ * before anything else touches the emulators.
+ */
+void AdlibMusic::stopRendering()
+{
+	if (renderThread)
+	{
+		stopRenderThread = true;
+		SDL_WaitThread(renderThread, 0);
+		renderThread = 0;
+	}
+}
+
+/**
+ * Fades out the music. A cached track is faded out as it's copied,
+ * over as many ticks as the player takes to fade it out.
+ */
+void AdlibMusic::fade()
+{
+	// the fade and the read position belong to the audio thread
+	SDL_LockAudio();
+	const AdlibMusic *music = current;
+	if (music && (music->_cacheState == ADLIB_CACHE_RENDERING || music->_cacheState == ADLIB_CACHE_COMPLETE ||
+		(music->_cacheState == ADLIB_CACHE_PARTIAL && music->_cachePos < music->_cached)))
+	{
+		fadeTotal = std::max(1, (int)(127 * music->_volume) * delayRates[rate] / (int)sizeof(Sint16));
+		fadeLeft = fadeTotal;
+	}
+	else
+	{
+		func_fade();
+	}
+	SDL_UnlockAudio();
+}
+
+/**
+ * Custom audio player.
+ * @param udata User data to send to the player.
+ * @param stream Raw audio to output.
+ * @param len Length of audio to output.
+ */
+void AdlibMusic::player(void *udata, Uint8 *stream, int len)
+{
+#ifndef __NO_MUSIC
+	// Check SDL volume for Background Mute functionality
+	if (Options::musicVolume == 0 || Mix_VolumeMusic(-1) == 0)
+		return;
+	float volume = Game::volumeExponent(Options::musicVolume);
+	const AdlibMusic *track = current;
+	if (track && track->_cacheState != ADLIB_CACHE_NONE)
+	{
+		track->playCached((Sint16*)stream, len / sizeof(Sint16), volume);
+		return;
+	}
+	if (Options::musicAlwaysLoop && !func_is_music_playing())
+	{
+		AdlibMusic *music = (AdlibMusic*)udata;
+		if (Options::oxceAdlibMusicCache > 0 && track)
+		{
+			// just start over, play() would start caching from the audio thread
+			func_setup_music((unsigned char*)track->_data, track->_size);
+			func_set_music_volume(127 * track->_volume);
+			return;
+		}
+		music->play();
+		return;
+	}
+	render(stream, len, volume);
 #endif
 }
 
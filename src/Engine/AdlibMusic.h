@@ -18,15 +18,23 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Music.h"
+#include <atomic>
 #include <map>
 #include <string>
+#include <vector>
+
+struct SDL_Thread;
 
 namespace OpenXcom
 {
 
+enum AdlibCacheState { ADLIB_CACHE_NONE, ADLIB_CACHE_RENDERING, ADLIB_CACHE_COMPLETE, ADLIB_CACHE_PARTIAL };
+
 /**
  * Container for Adlib music tracks.
  * Uses a custom YM3812 music player passed to SDL_mixer.
+ * Optionally renders the whole track to a PCM cache on a
+ * background thread, so the player only copies samples.
  */
 class AdlibMusic : public Music
 {
@@ -34,8 +42,30 @@ private:
 	char *_data;
 	size_t _size;
 	float _volume;
+	mutable std::vector< std::vector<Sint16> > _cache;
+	mutable std::atomic<size_t> _cached;
+	mutable std::atomic<int> _cacheState;
+	mutable size_t _cachePos, _cacheLoop, _cacheReserved;
 	static int delay, rate;
 	static std::map<int, int> delayRates;
+	static std::atomic<const AdlibMusic*> current;
+	static SDL_Thread *renderThread;
+	static std::atomic<bool> stopRenderThread;
+	static std::atomic<size_t> cacheBytes;
+	static int fadeLeft, fadeTotal;
+
+	/// Renders the music with the YM3812 emulator.
+	static void render(Uint8 *stream, int len, float volume);
+	/// Renders the track to the cache.
+	static int renderer(void *data);
+	/// Renders the next chunk of the track to the cache.
+	bool renderChunk() const;
+	/// Plays the track from the cache.
+	void playCached(Sint16 *stream, int samples, float volume) const;
+	/// Frees the cached track.
+	void clearCache() const;
+	/// Gets the volume of the fade out.
+	static float getFadeVolume();
 public:
 	/// Creates a blank music track.
 	AdlibMusic(float volume = 1.0f);
@@ -50,6 +80,10 @@ public:
 	/// Adlib music player.
 	static void player(void *udata, Uint8 *stream, int len);
 	bool isPlaying();
+	/// Stops rendering a track to the cache.
+	static void stopRendering();
+	/// Fades out the music.
+	static void fade();
 };
 
 }
@@ -36,11 +36,14 @@
  * A. somename.zip is always scanned before somename/ directory.
  */
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <istream>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <SDL_thread.h>
 
 #include "FileMap.h"
 #include "Unicode.h"
@@ -52,6 +55,16 @@
 #define MINIZ_NO_STDIO
 #include "../../libs/miniz/miniz.h"
 
+/**
+ * Zip contexts share their file handle, so only one
+ * file can be extracted at a time, whatever the thread.
+ */
+static SDL_mutex *getZipLock()
+{
+	static SDL_mutex *lock = SDL_CreateMutex();
+	return lock;
+}
+
 extern "C"
 {
 
@@ -66,7 +79,9 @@ int mzops_close(struct SDL_RWops *context) {
 }
 SDL_RWops *SDL_RWFromMZ(mz_zip_archive *zip, mz_uint file_index) {
 	size_t size;
+	SDL_LockMutex(getZipLock());
 	void *data = mz_zip_reader_extract_to_heap(zip, file_index, &size, 0);
+	SDL_UnlockMutex(getZipLock());
 	if (data == NULL) {
 		SDL_SetError("miniz extract: %s", mz_zip_get_error_string(mz_zip_get_last_error(zip)));
 		return NULL;
@@ -274,7 +289,9 @@ std::unique_ptr<std::istream> FileRecord::getIStream() const
 RawData FileRecord::getUnzippedData() const
 {
 	size_t size;
+	SDL_LockMutex(getZipLock());
 	void* data = mz_zip_reader_extract_to_heap((mz_zip_archive*)zip, findex, &size, 0);
+	SDL_UnlockMutex(getZipLock());
 	if (data == NULL)
 	{
 		auto err = "FileRecord::getIStream(): failed to decompress " + fullpath + ": ";
@@ -687,6 +704,22 @@ static std::unordered_set<VFSLayer *> MappedVFSLayers; // owned here so we can h
 													   // only the layers that get dropped on FileMap::clear()
 static std::vector<mz_zip_archive *> ZipContexts;	   // zip decompression contexts shared between layers that came from
 													   // the same .zip. this makes the whole thing very thread-unsafe
+
+/// A file read ahead by the prefetch threads.
+struct PrefetchedFile
+{
+	const FileRecord *record = 0;
+	RawData data;
+	bool started = false, ready = false, failed = false, taken = false;
+};
+static const size_t MAX_PREFETCH_THREADS = 4;
+static std::unordered_map<std::string, PrefetchedFile> Prefetched; // by canonical name, pointers stay valid until cleared
+static std::vector<PrefetchedFile *> PrefetchQueue;
+static size_t PrefetchNext = 0;
+static std::vector<SDL_Thread *> PrefetchThreads;
+static SDL_mutex *PrefetchLock = 0;
+static SDL_cond *PrefetchReady = 0;
+static bool PrefetchStop = false;
 static VFS TheVFS;
 
 static VFSLayer* MappedVFSLayersAdd(std::unique_ptr<VFSLayer>&& layer)
@@ -729,6 +762,7 @@ static mz_zip_archive *newZipContext(const std::string& log_ctx, SDL_RWops *rwop
 }
 
 void clear(bool clearOnly, bool embeddedOnly) {
+	clearPrefetched();
 	TheVFS.clear();
 	for (auto i : ModsAvailable ) { delete i.second; }
 	ModsAvailable.clear();
@@ -1294,8 +1328,167 @@ SDL_RWops *getRWopsReadAll(const std::string &relativeFilePath)
 }
 
 std::unique_ptr<std::istream> getIStream(const std::string &relativeFilePath) {
+	if (!Prefetched.empty())
+	{
+		auto it = Prefetched.find(canonicalize(relativeFilePath));
+		if (it != Prefetched.end() && !it->second.taken)
+		{
+			PrefetchedFile &file = it->second;
+			SDL_LockMutex(PrefetchLock);
+			// not started yet, just read it here
+			bool wait = file.started;
+			file.started = true;
+			while (wait && !file.ready)
+			{
+				SDL_CondWait(PrefetchReady, PrefetchLock);
+			}
+			RawData data = std::move(file.data);
+			bool read = file.ready && !file.failed;
+			file.taken = true;
+			SDL_UnlockMutex(PrefetchLock);
+			if (read)
+			{
+				return std::unique_ptr<std::istream>(new StreamData(std::move(data)));
+			}
+		}
+	}
 	return at(relativeFilePath)->getIStream();
 }
+
+/**
+ * Reads a whole file into memory, without logging errors
+ * so it can run on any thread.
+ * @param file File to read.
+ * @param data Returned file data.
+ * @return True if the file was read.
+ */
+static bool readFileQuietly(const FileRecord *file, RawData &data)
+{
+	size_t size;
+	if (file->zip != NULL)
+	{
+		SDL_LockMutex(getZipLock());
+		void *buffer = mz_zip_reader_extract_to_heap((mz_zip_archive*)file->zip, file->findex, &size, 0);
+		SDL_UnlockMutex(getZipLock());
+		if (buffer == NULL)
+		{
+			return false;
+		}
+		data = RawData(buffer, size, mz_free);
+		return true;
+	}
+	SDL_RWops *rwops = SDL_RWFromFile(file->fullpath.c_str(), "r");
+	if (!rwops)
+	{
+		return false;
+	}
+	void *buffer = SDL_LoadFile_RW(rwops, &size, SDL_TRUE);
+	if (buffer == NULL)
+	{
+		return false;
+	}
+	data = RawData(buffer, size, SDL_free);
+	return true;
+}
+
+/**
+ * Prefetch thread, reads the queued files until there are none left.
+ */
+static int prefetchFiles(void *)
+{
+	while (true)
+	{
+		SDL_LockMutex(PrefetchLock);
+		PrefetchedFile *file = 0;
+		while (!PrefetchStop && PrefetchNext < PrefetchQueue.size() && !file)
+		{
+			file = PrefetchQueue[PrefetchNext++];
+			if (file->started)
+			{
+				file = 0;
+			}
+		}
+		if (!file)
+		{
+			SDL_UnlockMutex(PrefetchLock);
+			return 0;
+		}
+		file->started = true;
+		SDL_UnlockMutex(PrefetchLock);
+
+		RawData data;
+		bool read = readFileQuietly(file->record, data);
+
+		SDL_LockMutex(PrefetchLock);
+		file->data = std::move(data);
+		file->failed = !read;
+		file->ready = true;
+		SDL_CondBroadcast(PrefetchReady);
+		SDL_UnlockMutex(PrefetchLock);
+	}
+}
+
+void prefetch(const std::vector<std::string> &relativeFilePaths)
+{
+	clearPrefetched();
+	for (const auto &path : relativeFilePaths)
+	{
+		const FileRecord *record = TheVFS.at(path);
+		if (record == NULL)
+		{
+			continue;
+		}
+		auto inserted = Prefetched.insert(std::make_pair(canonicalize(path), PrefetchedFile()));
+		if (inserted.second)
+		{
+			inserted.first->second.record = record;
+			PrefetchQueue.push_back(&inserted.first->second);
+		}
+	}
+	if (PrefetchQueue.empty())
+	{
+		return;
+	}
+	if (!PrefetchLock)
+	{
+		PrefetchLock = SDL_CreateMutex();
+		PrefetchReady = SDL_CreateCond();
+	}
+	PrefetchStop = false;
+	PrefetchNext = 0;
+	int threads = (int)std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), std::min<size_t>(MAX_PREFETCH_THREADS, PrefetchQueue.size()));
+	for (int i = 0; i < threads; ++i)
+	{
+		SDL_Thread *thread = SDL_CreateThread(prefetchFiles, 0);
+		if (thread)
+		{
+			PrefetchThreads.push_back(thread);
+		}
+	}
+	if (PrefetchThreads.empty())
+	{
+		// no threads, files are read when asked for
+		PrefetchQueue.clear();
+		Prefetched.clear();
+	}
+}
+
+void clearPrefetched()
+{
+	if (!PrefetchThreads.empty())
+	{
+		SDL_LockMutex(PrefetchLock);
+		PrefetchStop = true;
+		SDL_UnlockMutex(PrefetchLock);
+		for (auto *thread : PrefetchThreads)
+		{
+			SDL_WaitThread(thread, 0);
+		}
+		PrefetchThreads.clear();
+	}
+	PrefetchQueue.clear();
+	Prefetched.clear();
+}
 YAML::YamlRootNodeReader getYAML(const std::string &relativeFilePath) {
 	return at(relativeFilePath)->getYAML();
 }
@@ -72,6 +72,12 @@ namespace FileMap
 	/// Gets an std::istream interface to the file data. Has to be deleted on the caller's end.
 	std::unique_ptr<std::istream>getIStream(const std::string &relativeFilePath);
 
+	/// Starts reading files into memory on background threads, getIStream hands them out when asked for.
+	void prefetch(const std::vector<std::string> &relativeFilePaths);
+
+	/// Stops the background reads and frees the prefetched files nobody asked for.
+	void clearPrefetched();
+
 	/// Gets a 'vertical slice' through all the VFS layers for a given file name. (used for langs)
 	/// Beware of NULLs for the layers that miss the relpath.
 	const std::vector<const FileRecord *> getSlice(const std::string &relativeFilePath);
@@ -31,7 +31,9 @@
 #include <cassert>
 #include <string.h>
 #include <SDL_mixer.h>
+#include <SDL_thread.h>
 #include "FileMap.h"
+#include "SDL2Helpers.h"
 #include "Logger.h"
 #include "Screen.h"
 #include "Options.h"
@@ -79,7 +81,11 @@ enum PlayingState
 	SKIPPED
 };
 
-FlcPlayer::FlcPlayer() : _fileBuf(0), _mainScreen(0), _realScreen(0), _game(0)
+/// Video frames decoded ahead of the one shown.
+const size_t DECODE_AHEAD_FRAMES = 4;
+
+FlcPlayer::FlcPlayer() : _file(0), _fileLock(0), _fileSize(0), _chunkData(0), _framePalette(0), _queueFirst(0), _queueCount(0),
+	_decodeThread(0), _queueLock(0), _queueChanged(0), _stopDecoding(false), _mainScreen(0), _realScreen(0), _game(0)
 {
 	_volume = Game::volumeExponent(Options::musicVolume);
 }
@@ -90,7 +96,7 @@ FlcPlayer::~FlcPlayer()
 }
 
 /**
- * Initialize data structures needed buy the player and read the whole file into memory
+ * Initialize data structures needed buy the player and read the file header
  * @param filename Video file name
  * @param frameCallback Function to call each video frame
  * @param game Pointer to the Game instance
@@ -99,7 +105,7 @@ FlcPlayer::~FlcPlayer()
  */
 bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, bool useInternalAudio, int dx, int dy)
 {
-	if (_fileBuf != 0)
+	if (_file)
 	{
 		Log(LOG_ERROR) << "Trying to init a video player that is already initialized";
 		return false;
@@ -115,23 +121,29 @@ bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, b
 
 	_fileSize = 0;
 	_frameCount = 0;
-	_audioFrameData = 0;
 	_hasAudio = false;
 	_audioData.loadingBuffer = 0;
 	_audioData.playingBuffer = 0;
 
-	auto file = FileMap::getIStream(filename);
-	file->seekg(0, std::istream::end);
-	auto size = file->tellg();
-	file->seekg(0, std::istream::beg);
-	_fileBuf = new Uint8[size];
-	_fileSize = size;
-	file->read((char *)_fileBuf, size);
-
-	_audioFrameData = _fileBuf + 128;
+	// The video and the audio frames are read from the same file as they are needed,
+	// loose files stay on disk and only archived ones are unpacked into memory
+	_file = FileMap::getRWops(filename);
+	if (!_file)
+	{
+		return false;
+	}
+	Sint64 fileSize = SDL_RWsize(_file);
+	_fileSize = fileSize > 0 ? (Uint32)fileSize : 0;
+	_fileLock = SDL_CreateMutex();
 
 	// Let's read the first 128 bytes
-	readFileHeader();
+	std::vector<Uint8> header;
+	if (!readFile(0, header, 128))
+	{
+		Log(LOG_ERROR) << "Flx file is too short.";
+		return false;
+	}
+	readFileHeader(&header[0]);
 
 	// If it's a FLC or FLI file, it's ok
 	if (_headerType == SDL_SwapLE16(FLI_TYPE) || (_headerType == SDL_SwapLE16(FLC_TYPE)))
@@ -179,10 +191,20 @@ void FlcPlayer::deInit()
 		_mainScreen = 0;
 	}
 
-	if (_fileBuf != 0)
+	if (_file)
 	{
-		delete[] _fileBuf;
-		_fileBuf = 0;
+		stopDecoding();
+		SDL_RWclose(_file);
+		_file = 0;
+		if (_fileLock)
+		{
+			SDL_DestroyMutex(_fileLock);
+			_fileLock = 0;
+		}
+		std::vector<Uint8>().swap(_videoFrameBuf);
+		std::vector<Uint8>().swap(_audioFrameBuf);
+		std::vector<Uint8>().swap(_canvas);
+		std::vector<DecodedFrame>().swap(_queue);
 
 		deInitAudio();
 	}
@@ -201,8 +223,10 @@ void FlcPlayer::play(bool skipLastFrame)
 	_offset = _dy * _mainScreen->pitch + _mainScreen->format->BytesPerPixel * _dx;
 
 	// Skip file header
-	_videoFrameData = _fileBuf + 128;
-	_audioFrameData = _videoFrameData;
+	_videoFrameOffset = 128;
+	_audioFrameOffset = _videoFrameOffset;
+
+	startDecoding();
 
 	while (!shouldQuit())
 	{
@@ -218,6 +242,7 @@ void FlcPlayer::play(bool skipLastFrame)
 			SDLPolling();
 	}
 
+	stopDecoding();
 }
 
 void FlcPlayer::delay(Uint32 milliseconds)
@@ -268,15 +293,42 @@ bool FlcPlayer::shouldQuit()
 	return _playingState == FINISHED || _playingState == SKIPPED;
 }
 
-void FlcPlayer::readFileHeader()
+void FlcPlayer::readFileHeader(const Uint8 *header)
 {
-	readU32(_headerSize, _fileBuf);
-	readU16(_headerType, _fileBuf + 4);
-	readU16(_headerFrames, _fileBuf + 6);
-	readU16(_headerWidth, _fileBuf + 8);
-	readU16(_headerHeight, _fileBuf + 10);
-	readU16(_headerDepth, _fileBuf + 12);
-	readU16(_headerSpeed, _fileBuf + 16);
+	readU32(_headerSize, header);
+	readU16(_headerType, header + 4);
+	readU16(_headerFrames, header + 6);
+	readU16(_headerWidth, header + 8);
+	readU16(_headerHeight, header + 10);
+	readU16(_headerDepth, header + 12);
+	readU16(_headerSpeed, header + 16);
+}
+
+/**
+ * Reads part of the video file. The audio and the decoding
+ * thread share the file, so the seek and the read are locked.
+ * @param offset Offset of the data in the file.
+ * @param buf Buffer to read into, resized to fit.
+ * @param size Amount of bytes to read.
+ * @return False if the file is too short.
+ */
+bool FlcPlayer::readFile(Uint32 offset, std::vector<Uint8> &buf, Uint32 size)
+{
+	if (offset > _fileSize || size > _fileSize - offset)
+	{
+		return false;
+	}
+	buf.resize(std::max(size, (Uint32)1));
+	if (_fileLock)
+	{
+		SDL_LockMutex(_fileLock);
+	}
+	bool read = SDL_RWseek(_file, offset, RW_SEEK_SET) == (Sint64)offset && (size == 0 || SDL_RWread(_file, &buf[0], size, 1) == 1);
+	if (_fileLock)
+	{
+		SDL_UnlockMutex(_fileLock);
+	}
+	return read;
 }
 
 bool FlcPlayer::isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &frameType)
@@ -292,9 +344,9 @@ void FlcPlayer::decodeAudio(int frames)
 
 	int audioFramesFound = 0;
 
-	while (audioFramesFound < frames && !isEndOfFile(_audioFrameData))
+	while (audioFramesFound < frames && !isEndOfFile(_audioFrameOffset))
 	{
-		if (!isValidFrame(_audioFrameData, _audioFrameSize, _audioFrameType))
+		if (!readFile(_audioFrameOffset, _audioFrameBuf, 16) || !isValidFrame(&_audioFrameBuf[0], _audioFrameSize, _audioFrameType))
 		{
 			_playingState = FINISHED;
 			break;
@@ -304,18 +356,22 @@ void FlcPlayer::decodeAudio(int frames)
 		{
 			case FRAME_TYPE:
 			case PREFIX_CHUNK:
-				_audioFrameData += _audioFrameSize;
+				_audioFrameOffset += _audioFrameSize;
 				break;
 			case AUDIO_CHUNK:
 				Uint16 sampleRate;
 
-				readU16(sampleRate, _audioFrameData + 8);
+				readU16(sampleRate, &_audioFrameBuf[8]);
 
-				_chunkData = _audioFrameData + 16;
+				if (!readFile(_audioFrameOffset + 16, _audioFrameBuf, _audioFrameSize))
+				{
+					_playingState = FINISHED;
+					return;
+				}
 
-				playAudioFrame(sampleRate);
+				playAudioFrame(sampleRate, &_audioFrameBuf[0]);
 
-				_audioFrameData += _audioFrameSize + 16;
+				_audioFrameOffset += _audioFrameSize + 16;
 
 				++audioFramesFound;
 
@@ -324,111 +380,280 @@ void FlcPlayer::decodeAudio(int frames)
 	}
 }
 
+/**
+ * Shows the next video frame decoded ahead, when it's time.
+ * @param skipLastFrame Don't show the last frame of the video.
+ */
 void FlcPlayer::decodeVideo(bool skipLastFrame)
 {
-	bool videoFrameFound = false;
+	DecodedFrame *frame;
+	if (_decodeThread)
+	{
+		SDL_LockMutex(_queueLock);
+		while (_queueCount == 0)
+		{
+			SDL_CondWait(_queueChanged, _queueLock);
+		}
+		frame = &_queue[_queueFirst];
+		SDL_UnlockMutex(_queueLock);
+	}
+	else
+	{
+		frame = &_queue[0];
+		decodeVideoFrame(*frame);
+	}
 
-	while (!videoFrameFound)
+	if (!frame->valid)
+	{
+		_playingState = FINISHED;
+	}
+	else
 	{
-		if (!isValidFrame(_videoFrameData, _videoFrameSize, _videoFrameType))
+		Uint32 delay;
+
+		if (_headerType == FLI_TYPE)
 		{
+			delay = frame->delayOverride > 0 ? frame->delayOverride : _headerSpeed * (1000.0 / 70.0);
+		}
+		else if (_useInternalAudio && !_frameCallBack) // this means TFTD videos are playing
+		{
+			delay = _videoDelay;
+		}
+		else
+		{
+			delay = _headerSpeed;
+		}
+
+		waitForNextFrame(delay);
+
+		// If this frame is the last one, don't play it
+		if (frame->last)
 			_playingState = FINISHED;
-			break;
+
+		if(!shouldQuit() || !skipLastFrame)
+			playVideoFrame(*frame);
+	}
+
+	if (_decodeThread)
+	{
+		SDL_LockMutex(_queueLock);
+		_queueFirst = (_queueFirst + 1) % _queue.size();
+		--_queueCount;
+		SDL_CondSignal(_queueChanged);
+		SDL_UnlockMutex(_queueLock);
+	}
+}
+
+/**
+ * Reads and decodes the next video frame onto the canvas,
+ * keeping a copy of it and of its palette changes.
+ * @param frame Decoded frame to fill.
+ * @return False if there are no more frames.
+ */
+bool FlcPlayer::decodeVideoFrame(DecodedFrame &frame)
+{
+	frame.palette.clear();
+	frame.valid = false;
+	frame.last = false;
+
+	while (true)
+	{
+		if (!readFile(_videoFrameOffset, _videoFrameBuf, 16) || !isValidFrame(&_videoFrameBuf[0], _videoFrameSize, _videoFrameType))
+		{
+			return false;
 		}
 
 		switch (_videoFrameType)
 		{
 		case FRAME_TYPE:
-
-			Uint32 delay;
-
-			readU16(_frameChunks, _videoFrameData + 6);
-			readU16(_delayOverride, _videoFrameData + 8);
-
-			if (_headerType == FLI_TYPE)
+			if (_videoFrameSize < 16 || !readFile(_videoFrameOffset, _videoFrameBuf, _videoFrameSize))
 			{
-				delay = _delayOverride > 0 ? _delayOverride : _headerSpeed * (1000.0 / 70.0);
-			}
-			else if (_useInternalAudio && !_frameCallBack) // this means TFTD videos are playing
-			{
-				delay = _videoDelay;
-			}
-			else
-			{
-				delay = _headerSpeed;
+				return false;
 			}
 
-			waitForNextFrame(delay);
+			readU16(_frameChunks, &_videoFrameBuf[6]);
+			readU16(frame.delayOverride, &_videoFrameBuf[8]);
 
 			// Skip the frame header, we are not interested in the rest
-			_chunkData = _videoFrameData + 16;
+			_chunkData = _videoFrameBuf.data() + 16;
+			_framePalette = &frame.palette;
 
-			_videoFrameData += _videoFrameSize;
-			// If this frame is the last one, don't play it
-			if(isEndOfFile(_videoFrameData))
-				_playingState = FINISHED;
+			for (int i = 0; i < _frameChunks; ++i)
+			{
+				readU32(_chunkSize, _chunkData);
+				readU16(_chunkType, _chunkData + 4);
 
-			if(!shouldQuit() || !skipLastFrame)
-				playVideoFrame();
+				switch (_chunkType)
+				{
+					case COLOR_256:
+						color256();
+						break;
+					case FLI_SS2:
+						fliSS2();
+						break;
+					case COLOR_64:
+						color64();
+						break;
+					case FLI_LC:
+						fliLC();
+						break;
+					case BLACK:
+						black();
+						break;
+					case FLI_BRUN:
+						fliBRun();
+						break;
+					case FLI_COPY:
+						fliCopy();
+						break;
+					case 18:
+						break;
+					default:
+						Log(LOG_WARNING) << "Ieek an non implemented chunk type:" << _chunkType;
+						break;
+				}
 
-			videoFrameFound = true;
+				_chunkData += _chunkSize;
+			}
 
-			break;
+			_videoFrameOffset += _videoFrameSize;
+			frame.pixels = _canvas;
+			frame.valid = true;
+			frame.last = isEndOfFile(_videoFrameOffset);
+			return !frame.last;
 		case AUDIO_CHUNK:
-			_videoFrameData += _videoFrameSize + 16;
+			_videoFrameOffset += _videoFrameSize + 16;
 			break;
 		case PREFIX_CHUNK:
+			if (_videoFrameSize == 0)
+			{
+				return false;
+			}
 			// Just skip it
-			_videoFrameData += _videoFrameSize;
+			_videoFrameOffset += _videoFrameSize;
 
 			break;
 		}
 	}
 }
 
-void FlcPlayer::playVideoFrame()
+/**
+ * Entry point of the decoding thread.
+ * @param data Pointer to the player.
+ * @return Always 0.
+ */
+int FlcPlayer::decodeThread(void *data)
 {
-	++_frameCount;
-	if (SDL_LockSurface(_mainScreen) < 0)
-		return;
-	int chunkCount = _frameChunks;
+	((FlcPlayer*)data)->decodeFrames();
+	return 0;
+}
 
-	for (int i = 0; i < chunkCount; ++i)
+/**
+ * Decodes video frames into the queue until it's full,
+ * then waits for the main thread to show them.
+ */
+void FlcPlayer::decodeFrames()
+{
+	bool more = true;
+	while (more)
 	{
-		readU32(_chunkSize, _chunkData);
-		readU16(_chunkType, _chunkData + 4);
-
-		switch (_chunkType)
+		SDL_LockMutex(_queueLock);
+		while (_queueCount == _queue.size() && !_stopDecoding)
 		{
-			case COLOR_256:
-				color256();
-				break;
-			case FLI_SS2:
-				fliSS2();
-				break;
-			case COLOR_64:
-				color64();
-				break;
-			case FLI_LC:
-				fliLC();
-				break;
-			case BLACK:
-				black();
-				break;
-			case FLI_BRUN:
-				fliBRun();
-				break;
-			case FLI_COPY:
-				fliCopy();
-				break;
-			case 18:
-				break;
-			default:
-				Log(LOG_WARNING) << "Ieek an non implemented chunk type:" << _chunkType;
-				break;
+			SDL_CondWait(_queueChanged, _queueLock);
 		}
+		if (_stopDecoding)
+		{
+			SDL_UnlockMutex(_queueLock);
+			return;
+		}
+		DecodedFrame &frame = _queue[(_queueFirst + _queueCount) % _queue.size()];
+		SDL_UnlockMutex(_queueLock);
+
+		more = decodeVideoFrame(frame);
+
+		SDL_LockMutex(_queueLock);
+		++_queueCount;
+		SDL_CondSignal(_queueChanged);
+		SDL_UnlockMutex(_queueLock);
+	}
+}
+
+/**
+ * Starts decoding video frames ahead on a worker thread.
+ * If the thread can't be created, frames are decoded as they are shown.
+ */
+void FlcPlayer::startDecoding()
+{
+	_canvas.assign(_screenWidth * _screenHeight, 0);
+	_queue.assign(DECODE_AHEAD_FRAMES, DecodedFrame());
+	_queueFirst = 0;
+	_queueCount = 0;
+	_stopDecoding = false;
+	_queueLock = SDL_CreateMutex();
+	_queueChanged = SDL_CreateCond();
+	if (_queueLock && _queueChanged)
+	{
+		_decodeThread = SDL_CreateThread(decodeThread, this);
+	}
+	if (!_decodeThread)
+	{
+		Log(LOG_WARNING) << "Failed to start the video decoding thread, decoding on the main thread.";
+	}
+}
+
+/**
+ * Stops the decoding thread.
+ */
+void FlcPlayer::stopDecoding()
+{
+	if (_decodeThread)
+	{
+		SDL_LockMutex(_queueLock);
+		_stopDecoding = true;
+		SDL_CondSignal(_queueChanged);
+		SDL_UnlockMutex(_queueLock);
+		SDL_WaitThread(_decodeThread, 0);
+		_decodeThread = 0;
+	}
+	if (_queueChanged)
+	{
+		SDL_DestroyCond(_queueChanged);
+		_queueChanged = 0;
+	}
+	if (_queueLock)
+	{
+		SDL_DestroyMutex(_queueLock);
+		_queueLock = 0;
+	}
+}
+
+/**
+ * Shows a decoded video frame: applies its palette changes
+ * and copies it onto the screen.
+ * @param frame Decoded frame.
+ */
+void FlcPlayer::playVideoFrame(const DecodedFrame &frame)
+{
+	++_frameCount;
+	for (const auto &packet : frame.palette)
+	{
+		SDL_Color *colors = const_cast<SDL_Color*>(&packet.colors[0]);
+		if (_mainScreen != _realScreen->getSurface())
+			SDL_SetColors(_mainScreen, colors, packet.first, packet.colors.size());
+		_realScreen->setPalette(colors, packet.first, packet.colors.size(), true);
+	}
+
+	if (SDL_LockSurface(_mainScreen) < 0)
+		return;
 
-		_chunkData += _chunkSize;
+	int width = std::min(_screenWidth, _mainScreen->w - _dx);
+	int height = std::min(_screenHeight, _mainScreen->h - _dy);
+	Uint8 *pDst = (Uint8*)_mainScreen->pixels + _offset;
+	for (int y = 0; y < height; ++y)
+	{
+		memcpy(pDst, &frame.pixels[y * _screenWidth], width);
+		pDst += _mainScreen->pitch;
 	}
 
 	SDL_UnlockSurface(_mainScreen);
@@ -441,7 +666,21 @@ void FlcPlayer::playVideoFrame()
 	_realScreen->flip();
 }
 
-void FlcPlayer::playAudioFrame(Uint16 sampleRate)
+/**
+ * Keeps a palette change of the frame being decoded,
+ * it's applied when the frame is shown.
+ * @param first First color to change.
+ * @param count Amount of colors to change.
+ */
+void FlcPlayer::setColors(int first, int count)
+{
+	PalettePacket packet;
+	packet.first = first;
+	packet.colors.assign(_colors, _colors + count);
+	_framePalette->push_back(packet);
+}
+
+void FlcPlayer::playAudioFrame(Uint16 sampleRate, const Uint8 *data)
 {
 	/* TFTD audio header (10 bytes)
 	* Uint16 unknown1 - always 0
@@ -479,7 +718,7 @@ void FlcPlayer::playAudioFrame(Uint16 sampleRate)
 
 		for (unsigned int i = 0; i < _audioFrameSize; i++)
 		{
-			loadingBuff->samples[loadingBuff->sampleCount + i] = (float)((_chunkData[i]) -128) * 240 * _volume;
+			loadingBuff->samples[loadingBuff->sampleCount + i] = (float)((data[i]) -128) * 240 * _volume;
 		}
 		loadingBuff->sampleCount += _audioFrameSize;
 
@@ -518,9 +757,7 @@ void FlcPlayer::color256()
 			_colors[i].b = *(pSrc++);
 		}
 
-		if (_mainScreen != _realScreen->getSurface())
-			SDL_SetColors(_mainScreen, _colors, numColorsSkip, numColors);
-		_realScreen->setPalette(_colors, numColorsSkip, numColors, true);
+		setColors(numColorsSkip, numColors);
 
 		if (numColorPackets >= 1)
 		{
@@ -540,7 +777,7 @@ void FlcPlayer::fliSS2()
 	Uint8 lastByte = 0;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 	readU16(lines, pSrc);
 
 	pSrc += 2;
@@ -552,7 +789,7 @@ void FlcPlayer::fliSS2()
 
 		if ((count & MASK) == SKIP_LINES)
 		{
-			pDst += (-count)*_mainScreen->pitch;
+			pDst += (-count)*_screenWidth;
 			++lines;
 			continue;
 		}
@@ -601,9 +838,9 @@ void FlcPlayer::fliSS2()
 			if (setLastByte)
 			{
 				setLastByte = false;
-				*(pDst + _mainScreen->pitch - 1) = lastByte;
+				*(pDst + _screenWidth - 1) = lastByte;
 			}
-			pDst += _mainScreen->pitch;
+			pDst += _screenWidth;
 		}
 	}
 }
@@ -616,7 +853,7 @@ void FlcPlayer::fliBRun()
 
 	heightCount = _headerHeight;
 	pSrc = _chunkData + 6; // Skip chunk header
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	while (heightCount--)
 	{
@@ -648,7 +885,7 @@ void FlcPlayer::fliBRun()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _screenWidth;
 	}
 }
 
@@ -663,11 +900,11 @@ void FlcPlayer::fliLC()
 	int packetsCount;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	readU16(tmp, pSrc);
 	pSrc += 2;
-	pDst += tmp*_mainScreen->pitch;
+	pDst += tmp*_screenWidth;
 	readU16(lines, pSrc);
 	pSrc += 2;
 
@@ -702,7 +939,7 @@ void FlcPlayer::fliLC()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _screenWidth;
 	}
 }
 
@@ -733,9 +970,7 @@ void FlcPlayer::color64()
 			_colors[i].b = *(pSrc++) << 2;
 		}
 
-		if (_mainScreen != _realScreen->getSurface())
-			SDL_SetColors(_mainScreen, _colors, NumColorsSkip, NumColors);
-		_realScreen->setPalette(_colors, NumColorsSkip, NumColors, true);
+		setColors(NumColorsSkip, NumColors);
 	}
 }
 
@@ -744,13 +979,13 @@ void FlcPlayer::fliCopy()
 	Uint8 *pSrc, *pDst;
 	int Lines = _screenHeight;
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	while (Lines--)
 	{
 		memcpy(pDst, pSrc, _screenWidth);
 		pSrc += _screenWidth;
-		pDst += _mainScreen->pitch;
+		pDst += _screenWidth;
 	}
 }
 
@@ -758,12 +993,12 @@ void FlcPlayer::black()
 {
 	Uint8 *pDst;
 	int Lines = _screenHeight;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	while (Lines-- > 0)
 	{
-		memset(pDst, 0, _screenHeight);
-		pDst += _mainScreen->pitch;
+		memset(pDst, 0, _screenWidth);
+		pDst += _screenWidth;
 	}
 }
 
@@ -875,9 +1110,9 @@ void FlcPlayer::stop()
 	_playingState = FINISHED;
 }
 
-bool FlcPlayer::isEndOfFile(Uint8 *pos)
+bool FlcPlayer::isEndOfFile(Uint32 offset)
 {
-	return (pos - _fileBuf) == (int)(_fileSize); // should be Sint64, but let's assume the videos won't be 2gb
+	return offset >= _fileSize;
 }
 
 int FlcPlayer::getFrameCount()
@@ -914,7 +1149,7 @@ void FlcPlayer::waitForNextFrame(Uint32 delay)
 	{
 		while (currentTick < newTick)
 		{
-			while ((newTick - currentTick) > 10 && !isEndOfFile(_audioFrameData))
+			while ((newTick - currentTick) > 10 && !isEndOfFile(_audioFrameOffset))
 			{
 				decodeAudio(1);
 				currentTick = SDL_GetTicks();
@@ -23,6 +23,7 @@
  * Based on http://www.libsdl.org/projects/flxplay/
  */
 #include <SDL.h>
+#include <vector>
 
 namespace OpenXcom
 {
@@ -30,15 +31,45 @@ namespace OpenXcom
 class Screen;
 class Game;
 
+/**
+ * Plays FLI/FLC videos. The file is read frame by frame as needed,
+ * and a worker thread decodes the next few video frames ahead
+ * while the main thread times and shows them.
+ */
 class FlcPlayer
 {
 private:
 
-	Uint8 *_fileBuf;
+	/// Palette change made by a frame.
+	struct PalettePacket
+	{
+		int first;
+		std::vector<SDL_Color> colors;
+	};
+
+	/// Video frame decoded ahead.
+	struct DecodedFrame
+	{
+		std::vector<Uint8> pixels;
+		std::vector<PalettePacket> palette;
+		Uint16 delayOverride;
+		bool valid, last;
+	};
+
+	SDL_RWops *_file;
+	SDL_mutex *_fileLock;
 	Uint32 _fileSize;
-	Uint8 *_videoFrameData;
+	Uint32 _videoFrameOffset, _audioFrameOffset;
+	std::vector<Uint8> _videoFrameBuf, _audioFrameBuf;
 	Uint8 *_chunkData;
-	Uint8 *_audioFrameData;
+	std::vector<Uint8> _canvas;
+	std::vector<PalettePacket> *_framePalette;
+	std::vector<DecodedFrame> _queue;
+	size_t _queueFirst, _queueCount;
+	SDL_Thread *_decodeThread;
+	SDL_mutex *_queueLock;
+	SDL_cond *_queueChanged;
+	bool _stopDecoding;
 	Uint16 _frameCount;    /* Frame Counter */
 	Uint32 _headerSize;    /* Fli file size */
 	Uint16 _headerType;    /* Fli header check */
@@ -97,7 +128,8 @@ private:
 	void readU32(Uint32 &dst, const Uint8 *const src);
 	void readS16(Sint16 &dst, const Sint8 *const src);
 	void readS32(Sint32 &dst, const Sint8 *const src);
-	void readFileHeader();
+	void readFileHeader(const Uint8 *header);
+	bool readFile(Uint32 offset, std::vector<Uint8> &buf, Uint32 size);
 
 	bool isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &frameType);
 	void decodeVideo(bool skipLastFrame);
@@ -106,7 +138,14 @@ private:
 	void SDLPolling();
 	bool shouldQuit();
 
-	void playVideoFrame();
+	bool decodeVideoFrame(DecodedFrame &frame);
+	static int decodeThread(void *data);
+	void decodeFrames();
+	void startDecoding();
+	void stopDecoding();
+
+	void playVideoFrame(const DecodedFrame &frame);
+	void setColors(int first, int count);
 	void color256();
 	void fliBRun();
 	void fliCopy();
@@ -115,11 +154,11 @@ private:
 	void color64();
 	void black();
 
-	void playAudioFrame(Uint16 sampleRate);
+	void playAudioFrame(Uint16 sampleRate, const Uint8 *data);
 	void initAudio(Uint16 format, Uint8 channels);
 	void deInitAudio();
 
-	bool isEndOfFile(Uint8 *pos);
+	bool isEndOfFile(Uint32 offset);
 
 	static void audioCallback(void *userData, Uint8 *stream, int len);
 
@@ -55,7 +55,7 @@ const double Game::VOLUME_GRADIENT = 10.0;
  * creates the display screen and sets up the cursor.
  * @param title Title of the game window.
  */
-Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _update(false),  _mouseActive(true), _timeUntilNextFrame(0),
+Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _update(false), _exitCode(0), _mouseActive(true), _timeUntilNextFrame(0),
 	_ctrl(false), _alt(false), _shift(false), _rmb(false), _mmb(false)
 {
 	Options::reload = false;
@@ -98,7 +98,7 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	SDL_SetCursor(SDL_CreateCursor(&cursor, &cursor, 1,1,0,0));
 
 	// Create fps counter
-	_fpsCounter = new FpsCounter(15, 5, 0, 0);
+	_fpsCounter = new FpsCounter(15, 17, 0, 0);
 
 	// Create blank language
 	_lang = new Language();
@@ -151,6 +151,8 @@ void Game::run()
 
 	while (!_quit)
 	{
+		Sound::newFrame();
+
 		// Clean up states
 		while (!_deleted.empty())
 		{
@@ -192,6 +194,7 @@ void Game::run()
 					// An event other than SDL_APPMOUSEFOCUS change happened.
 					if (reinterpret_cast<SDL_ActiveEvent*>(&_event)->state & ~SDL_APPMOUSEFOCUS)
 					{
+						_screen->invalidate();
 						Uint8 currentState = SDL_GetAppState();
 						// Game is minimized
 						if (!(currentState & SDL_APPACTIVE))
@@ -222,6 +225,9 @@ void Game::run()
 						}
 					}
 					break;
+				case SDL_VIDEOEXPOSE:
+					_screen->invalidate();
+					break;
 				case SDL_VIDEORESIZE:
 					if (Options::allowResize)
 					{
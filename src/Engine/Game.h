@@ -51,6 +51,7 @@ private:
 	SavedGame *_save;
 	Mod *_mod;
 	bool _quit, _init, _update;
+	int _exitCode;
 	FpsCounter *_fpsCounter;
 	bool _mouseActive;
 	unsigned int _timeOfLastFrame;
@@ -111,6 +112,10 @@ public:
 	void setUpdateFlag(bool update) { _update = update; }
 	/// Returns the update flag.
 	bool getUpdateFlag() const { return _update; }
+	/// Sets the process exit code.
+	void setExitCode(int code) { _exitCode = code; }
+	/// Returns the process exit code.
+	int getExitCode() const { return _exitCode; }
 
 	/// Is CTRL pressed?
 	bool isCtrlPressed(bool considerTouchButtons = false) const;
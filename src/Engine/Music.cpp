@@ -104,6 +104,8 @@ void Music::play(int loop) const
 void Music::stop()
 {
 #ifndef __NO_MUSIC
+	// nothing else may use the emulators while a track is rendered
+	AdlibMusic::stopRendering();
 	if (!Options::mute)
 	{
 		func_mute();
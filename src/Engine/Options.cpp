@@ -57,6 +57,8 @@ int _passwordCheck = -1;
 bool _loadLastSave = false;
 std::string _loadThisSave = "";
 bool _loadLastSaveExpended = false;
+std::string _dogfightBenchmark = "";
+std::string _exportTechGraph = "";
 
 /**
  * Sets up the options by creating their OptionInfo metadata.
@@ -371,6 +373,13 @@ void createOptionsOXCE()
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceEmbeddedOnly", &oxceEmbeddedOnly, true));
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceListVFSContents", &oxceListVFSContents, false));
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceEnablePaletteFlickerFix", &oxceEnablePaletteFlickerFix, false));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceSkipUnchangedFrames", &oxceSkipUnchangedFrames, true));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceGeoFastForwardQuietPeriods", &oxceGeoFastForwardQuietPeriods, true));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceTextCache", &oxceTextCache, true));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceAdlibMusicCache", &oxceAdlibMusicCache, 0));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceMapBlockCache", &oxceMapBlockCache, 32));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceMapBlockCacheWarmup", &oxceMapBlockCacheWarmup, false));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceSoundVoiceLimit", &oxceSoundVoiceLimit, 4));
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceRecommendedOptionsWereSet", &oxceRecommendedOptionsWereSet, false));
 	_info.push_back(OptionInfo(OPTION_OXCE, "password", &password, "secret"));
 
@@ -679,6 +688,14 @@ static void loadArgs()
 					_loadLastSave = true;
 					_loadThisSave = argv[i];
 				}
+				else if (argname == "dogfightbenchmark")
+				{
+					_dogfightBenchmark = argv[i];
+				}
+				else if (argname == "exporttechgraph")
+				{
+					_exportTechGraph = argv[i];
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -717,6 +734,12 @@ static bool showHelp()
 	help << "        load last save" << std::endl << std::endl;
 	help << "-load FILENAME" << std::endl;
 	help << "        load the specified FILENAME (from the corresponding master mod subfolder)" << std::endl << std::endl;
+	help << "-dogfightBenchmark CRAFT:WEAPON,...:UFO[:RUNS[:MODE[:DIFFICULTY[:SEED]]]]" << std::endl;
+	help << "        simulate RUNS interceptions (default 10000) after loading the mods, print the statistics and quit" << std::endl;
+	help << "        MODE is cautious, standard (default) or aggressive (eg. -dogfightBenchmark STR_INTERCEPTOR:STR_AVALANCHE_LAUNCHER,STR_CANNON_UC:STR_SMALL_SCOUT)" << std::endl << std::endl;
+	help << "-exportTechGraph FILENAME" << std::endl;
+	help << "        write the research/manufacture/item dependency graph of the loaded mods to FILENAME and quit" << std::endl;
+	help << "        (JSON if FILENAME ends with .json, Graphviz DOT otherwise)" << std::endl << std::endl;
 	help << "-version" << std::endl;
 	help << "        show version number" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -1124,6 +1147,16 @@ const std::string& getLoadThisSave()
 	return _loadThisSave;
 }
 
+const std::string& getDogfightBenchmark()
+{
+	return _dogfightBenchmark;
+}
+
+const std::string& getExportTechGraph()
+{
+	return _exportTechGraph;
+}
+
 void expendLoadLastSave()
 {
 	_loadLastSaveExpended = true;
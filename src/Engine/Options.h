@@ -133,6 +133,10 @@ namespace Options
 	bool getLoadLastSave();
 	/// If we should skip the main menu and just load the specified save
 	const std::string& getLoadThisSave();
+	/// Dogfight benchmark to run instead of the game, if any
+	const std::string& getDogfightBenchmark();
+	/// File to export the tech dependency graph to instead of running the game, if any
+	const std::string& getExportTechGraph();
 	/// And do it only at startup
 	void expendLoadLastSave();
 }
@@ -120,6 +120,13 @@ OPT bool oxceDisableThinkingProgressBar;
 OPT bool oxceEmbeddedOnly;
 OPT bool oxceListVFSContents;
 OPT bool oxceEnablePaletteFlickerFix;
+OPT bool oxceSkipUnchangedFrames;
+OPT bool oxceGeoFastForwardQuietPeriods;
+OPT bool oxceTextCache;
+OPT int oxceAdlibMusicCache; // MB of pre-rendered Adlib music, 0 = off
+OPT int oxceMapBlockCache; // MB of MAP/RMP files kept between missions, 0 = off
+OPT bool oxceMapBlockCacheWarmup;
+OPT int oxceSoundVoiceLimit; // voices of the same sound playing at once, 0 = off
 OPT bool oxceRecommendedOptionsWereSet;
 OPT std::string password;
 
@@ -0,0 +1,299 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PaletteConverter.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (__i386__ || __x86_64__)
+#define OXCE_PALETTE_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Lookup tables built for one palette and output format.
+ */
+struct PaletteLut
+{
+	std::array<SDL_Color, 256> colors;
+	Uint32 rmask, gmask, bmask, amask;
+	std::array<Uint32, 256> single;
+	std::vector<Uint64> pairs;
+	Uint32 lastUse, builtAt;
+	bool built;
+
+	/// Checks if this table was built for the given palette and format.
+	bool match(const SDL_Color *c, const SDL_PixelFormat *format) const
+	{
+		return rmask == format->Rmask && gmask == format->Gmask && bmask == format->Bmask && amask == format->Amask
+			&& memcmp(colors.data(), c, sizeof(SDL_Color) * 256) == 0;
+	}
+
+	/// Builds the single index table, the pair table waits until the palette settles.
+	void build(const SDL_Color *c, const SDL_PixelFormat *format)
+	{
+		memcpy(colors.data(), c, sizeof(SDL_Color) * 256);
+		rmask = format->Rmask;
+		gmask = format->Gmask;
+		bmask = format->Bmask;
+		amask = format->Amask;
+		for (int i = 0; i < 256; ++i)
+		{
+			single[i] = SDL_MapRGB(format, c[i].r, c[i].g, c[i].b);
+		}
+		pairs.clear();
+		builtAt = SDL_GetTicks();
+		built = true;
+	}
+
+	/// Builds the pair table.
+	void buildPairs()
+	{
+		pairs.resize(256 * 256);
+		for (int hi = 0; hi < 256; ++hi)
+		{
+			for (int lo = 0; lo < 256; ++lo)
+			{
+				// key is two bytes read as a native 16bit word and value is two pixels written as a native 64bit word,
+				// so on both byte orders the first pixel ends up in the same half as the first index
+				pairs[(hi << 8) | lo] = ((Uint64)single[hi] << 32) | single[lo];
+			}
+		}
+	}
+};
+
+const int LUT_CACHE_SIZE = 4;
+/// How long a palette must stay in use before its 512KB pair table is worth building.
+const Uint32 PAIR_TABLE_DELAY = 250;
+PaletteLut lutCache[LUT_CACHE_SIZE];
+Uint32 lutClock = 0;
+
+/**
+ * Finds the tables for a palette, building them if needed.
+ * Recently used palettes are kept so screens with mixed palettes
+ * don't rebuild tables on every call. The pair table is only built
+ * once a palette has been in use for a while, so a palette fade,
+ * which changes the palette every frame, only builds the small ones.
+ */
+const PaletteLut &getLut(const SDL_Color *colors, const SDL_PixelFormat *format)
+{
+	++lutClock;
+	PaletteLut *oldest = &lutCache[0];
+	for (auto &lut : lutCache)
+	{
+		if (lut.built && lut.match(colors, format))
+		{
+			lut.lastUse = lutClock;
+			if (lut.pairs.empty() && SDL_GetTicks() - lut.builtAt >= PAIR_TABLE_DELAY)
+			{
+				lut.buildPairs();
+			}
+			return lut;
+		}
+		if (!lut.built || lut.lastUse < oldest->lastUse)
+		{
+			oldest = &lut;
+		}
+	}
+	oldest->build(colors, format);
+	oldest->lastUse = lutClock;
+	return *oldest;
+}
+
+#ifdef OXCE_PALETTE_AVX2
+/**
+ * Converts pixels 8 at a time using gathers from the single index table.
+ */
+__attribute__((target("avx2")))
+int convertAVX2(const Uint8 *src, Uint32 *dst, int width, const Uint32 *single, int colorKey)
+{
+	const __m256i key = _mm256_set1_epi32(colorKey);
+	int x = 0;
+	for (; x + 8 <= width; x += 8)
+	{
+		__m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + x)));
+		__m256i pix = _mm256_i32gather_epi32((const int*)single, idx, 4);
+		if (colorKey >= 0)
+		{
+			__m256i old = _mm256_loadu_si256((const __m256i*)(dst + x));
+			pix = _mm256_blendv_epi8(pix, old, _mm256_cmpeq_epi32(idx, key));
+		}
+		_mm256_storeu_si256((__m256i*)(dst + x), pix);
+	}
+	return x;
+}
+#endif
+
+/**
+ * Converts a row using the prepared tables.
+ */
+void convertRowLut(const Uint8 *src, Uint32 *dst, int width, const PaletteLut &lut, int colorKey)
+{
+	static const bool useAVX2 = PaletteConverter::haveAVX2();
+	int x = 0;
+#ifdef OXCE_PALETTE_AVX2
+	if (useAVX2)
+	{
+		x = convertAVX2(src, dst, width, lut.single.data(), colorKey);
+	}
+#else
+	(void)useAVX2;
+#endif
+	// no pair table while the palette is still changing
+	if (!lut.pairs.empty())
+	{
+		if (colorKey < 0)
+		{
+			for (; x + 2 <= width; x += 2)
+			{
+				Uint16 key;
+				memcpy(&key, src + x, sizeof(key));
+				Uint64 pair = lut.pairs[key];
+				memcpy(dst + x, &pair, sizeof(pair));
+			}
+		}
+		else
+		{
+			for (; x + 2 <= width; x += 2)
+			{
+				if (src[x] != colorKey && src[x + 1] != colorKey)
+				{
+					Uint16 key;
+					memcpy(&key, src + x, sizeof(key));
+					Uint64 pair = lut.pairs[key];
+					memcpy(dst + x, &pair, sizeof(pair));
+				}
+				else
+				{
+					if (src[x] != colorKey) dst[x] = lut.single[src[x]];
+					if (src[x + 1] != colorKey) dst[x + 1] = lut.single[src[x + 1]];
+				}
+			}
+		}
+	}
+	for (; x < width; ++x)
+	{
+		if (src[x] != colorKey)
+		{
+			dst[x] = lut.single[src[x]];
+		}
+	}
+}
+
+}
+
+/**
+ * Checks the AVX2 feature bit returned by the CPUID instruction.
+ * @return Does the CPU support AVX2?
+ */
+bool PaletteConverter::haveAVX2()
+{
+#ifdef OXCE_PALETTE_AVX2
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+/**
+ * Converts a run of palette indices into pixels of the given format.
+ * @param src Source palette indices.
+ * @param dst Destination pixels.
+ * @param width Number of pixels.
+ * @param colors Palette with 256 colors.
+ * @param format Format of the destination pixels.
+ * @param colorKey Index that is left transparent, or -1 for none.
+ */
+void PaletteConverter::convertRow(const Uint8 *src, Uint32 *dst, int width, const SDL_Color *colors, const SDL_PixelFormat *format, int colorKey)
+{
+	convertRowLut(src, dst, width, getLut(colors, format), colorKey);
+}
+
+/**
+ * Copies an area of an 8bpp surface onto a 32bpp surface,
+ * honoring the source color key and the destination clip rectangle
+ * the same way SDL_BlitSurface does.
+ * @param src 8bpp source surface.
+ * @param srcRect Area of the source to copy, or null for the whole surface.
+ * @param dst 32bpp destination surface.
+ * @param dstX Destination X position.
+ * @param dstY Destination Y position.
+ */
+void PaletteConverter::blit(SDL_Surface *src, const SDL_Rect *srcRect, SDL_Surface *dst, int dstX, int dstY)
+{
+	int sx = 0, sy = 0, w = src->w, h = src->h;
+	if (srcRect)
+	{
+		sx = std::max<int>(srcRect->x, 0);
+		sy = std::max<int>(srcRect->y, 0);
+		dstX += sx - srcRect->x;
+		dstY += sy - srcRect->y;
+		w = std::min<int>(srcRect->x + srcRect->w, src->w) - sx;
+		h = std::min<int>(srcRect->y + srcRect->h, src->h) - sy;
+	}
+
+	const SDL_Rect &clip = dst->clip_rect;
+	if (dstX < clip.x)
+	{
+		sx += clip.x - dstX;
+		w -= clip.x - dstX;
+		dstX = clip.x;
+	}
+	if (dstY < clip.y)
+	{
+		sy += clip.y - dstY;
+		h -= clip.y - dstY;
+		dstY = clip.y;
+	}
+	w = std::min(w, clip.x + clip.w - dstX);
+	h = std::min(h, clip.y + clip.h - dstY);
+	if (w <= 0 || h <= 0)
+	{
+		return;
+	}
+
+	const PaletteLut &lut = getLut(src->format->palette->colors, dst->format);
+	const int colorKey = (src->flags & SDL_SRCCOLORKEY) ? (int)src->format->colorkey : -1;
+
+	if (SDL_MUSTLOCK(dst))
+	{
+		SDL_LockSurface(dst);
+	}
+	for (int y = 0; y < h; ++y)
+	{
+		const Uint8 *s = (const Uint8*)src->pixels + (sy + y) * src->pitch + sx;
+		Uint32 *d = (Uint32*)((Uint8*)dst->pixels + (dstY + y) * dst->pitch) + dstX;
+		convertRowLut(s, d, w, lut, colorKey);
+	}
+	if (SDL_MUSTLOCK(dst))
+	{
+		SDL_UnlockSurface(dst);
+	}
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <SDL.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Converts 8bpp palettized pixels into 32bpp pixels.
+ * Keeps lookup tables for the most recently used palettes:
+ * one mapping a single index to a pixel and one mapping a pair
+ * of indices to two packed pixels, so the inner loop does
+ * one load and one store per two pixels.
+ * On CPUs with AVX2 the single index table is used with gathers instead.
+ */
+class PaletteConverter
+{
+public:
+	/// Copies an area of an 8bpp surface onto a 32bpp surface, clipped to the destination.
+	static void blit(SDL_Surface *src, const SDL_Rect *srcRect, SDL_Surface *dst, int dstX, int dstY);
+	/// Converts a run of 8bpp pixels into 32bpp pixels.
+	static void convertRow(const Uint8 *src, Uint32 *dst, int width, const SDL_Color *colors, const SDL_PixelFormat *format, int colorKey = -1);
+	/// Checks for AVX2 instructions using CPUID.
+	static bool haveAVX2();
+};
+
+}
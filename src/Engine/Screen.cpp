@@ -112,7 +112,7 @@ void Screen::makeVideoFlags()
  * Initializes a new display screen for the game to render contents to.
  * The screen is set up based on the current options.
  */
-Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false)
+Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false), _redrawAll(true)
 {
 	_flickerFix = Options::oxceEnablePaletteFlickerFix;
 
@@ -181,15 +181,81 @@ void Screen::handle(Action *action)
 }
 
 
+/**
+ * Compares the buffer with the copy of the last presented frame
+ * and updates that copy with the changed rows.
+ * @param firstRow Returns the first changed row.
+ * @param lastRow Returns one past the last changed row.
+ * @return True if anything changed.
+ */
+bool Screen::getDirtyRows(int &firstRow, int &lastRow)
+{
+	const size_t pitch = _surface->pitch;
+	const size_t size = pitch * _surface->h;
+	const Uint8 *pixels = (const Uint8*)_surface->pixels;
+
+	if (_prevFrame.size() != size)
+	{
+		_prevFrame.assign(pixels, pixels + size);
+		firstRow = 0;
+		lastRow = _surface->h;
+		return true;
+	}
+
+	firstRow = 0;
+	while (firstRow < _surface->h && memcmp(&_prevFrame[firstRow * pitch], pixels + firstRow * pitch, pitch) == 0)
+	{
+		++firstRow;
+	}
+	if (firstRow == _surface->h)
+	{
+		lastRow = firstRow;
+		return false;
+	}
+	lastRow = _surface->h;
+	while (lastRow > firstRow + 1 && memcmp(&_prevFrame[(lastRow - 1) * pitch], pixels + (lastRow - 1) * pitch, pitch) == 0)
+	{
+		--lastRow;
+	}
+	memcpy(&_prevFrame[firstRow * pitch], pixels + firstRow * pitch, (lastRow - firstRow) * pitch);
+	return true;
+}
+
 /**
  * Renders the buffer's contents onto the screen, applying
  * any necessary filters or conversions in the process.
  * If the scaling factor is bigger than 1, the entire contents
  * of the buffer are resized by that factor (eg. 2 = doubled)
  * before being put on screen.
+ * Frames identical to the previous one are skipped, and on
+ * software displays only the changed rows are converted and updated.
  */
 void Screen::flip()
 {
+	int firstRow = 0, lastRow = _surface->h;
+	bool dirty = getDirtyRows(firstRow, lastRow);
+	if (!Options::oxceSkipUnchangedFrames || (useOpenGL() && Options::vSyncForOpenGL))
+	{
+		// vsync-paced output needs a real flip every frame
+		_redrawAll = true;
+	}
+	if (!dirty && !_redrawAll)
+	{
+		return;
+	}
+
+	// partial updates only work when we are not page flipping and the zoom can redraw a range of rows
+	int zoomWidth = getWidth() - _leftBlackBand - _rightBlackBand;
+	int zoomHeight = getHeight() - _topBlackBand - _bottomBlackBand;
+	bool partial = !_redrawAll && !(_screen->flags & (SDL_HWSURFACE | SDL_DOUBLEBUF)) && !useOpenGL() && Zoom::canZoomRows(_surface->w, _surface->h, zoomWidth, zoomHeight);
+	if (!partial)
+	{
+		firstRow = 0;
+		lastRow = _surface->h;
+		Surface::CleanSdlSurface(_screen);
+	}
+	_redrawAll = false;
+
 	// perform any requested palette update
 	if (_flickerFix && _pushPalette && _numColors && _screen->format->BitsPerPixel == 8)
 	{
@@ -201,13 +267,19 @@ void Screen::flip()
 		_pushPalette = false;
 	}
 
+	int screenFirstRow = firstRow, screenLastRow = lastRow;
 	if (getWidth() != _baseWidth || getHeight() != _baseHeight || useOpenGL())
 	{
-		Zoom::flipWithZoom(_surface.get(), _screen, _topBlackBand, _bottomBlackBand, _leftBlackBand, _rightBlackBand, &glOutput);
+		Zoom::flipWithZoom(_surface.get(), _screen, _topBlackBand, _bottomBlackBand, _leftBlackBand, _rightBlackBand, &glOutput, firstRow, lastRow);
+		Zoom::getZoomedRows(_surface->w, _surface->h, zoomWidth, zoomHeight, firstRow, lastRow, screenFirstRow, screenLastRow);
+		screenFirstRow += _topBlackBand;
+		screenLastRow += _topBlackBand;
 	}
 	else
 	{
-		SDL_BlitSurface(_surface.get(), 0, _screen, 0);
+		SDL_Rect band = {0, (Sint16)firstRow, (Uint16)_surface->w, (Uint16)(lastRow - firstRow)};
+		SDL_Rect bandDst = band;
+		SDL_BlitSurface(_surface.get(), &band, _screen, &bandDst);
 	}
 
 	// perform any requested palette update
@@ -221,9 +293,11 @@ void Screen::flip()
 		_pushPalette = false;
 	}
 
-
-
-	if (SDL_Flip(_screen) == -1)
+	if (partial)
+	{
+		SDL_UpdateRect(_screen, 0, screenFirstRow, getWidth(), screenLastRow - screenFirstRow);
+	}
+	else if (SDL_Flip(_screen) == -1)
 	{
 		throw Exception(SDL_GetError());
 	}
@@ -231,11 +305,20 @@ void Screen::flip()
 
 /**
  * Clears all the contents out of the internal buffer.
+ * The display itself is only cleared on the next full redraw.
  */
 void Screen::clear()
 {
 	Surface::CleanSdlSurface(_surface.get());
-	Surface::CleanSdlSurface(_screen);
+}
+
+/**
+ * Makes the next flip redraw and present the whole
+ * screen, even if the buffer did not change.
+ */
+void Screen::invalidate()
+{
+	_redrawAll = true;
 }
 
 /**
@@ -263,6 +346,7 @@ void Screen::setPalette(const SDL_Color* colors, int firstcolor, int ncolors, bo
 	}
 
 	SDL_SetColors(_surface.get(), const_cast<SDL_Color *>(colors), firstcolor, ncolors);
+	_redrawAll = true;
 
 	// defer actual update of screen until SDL_Flip()
 	if (immediately && _screen->format->BitsPerPixel == 8 && SDL_SetColors(_screen, const_cast<SDL_Color *>(colors), firstcolor, ncolors) == 0)
@@ -349,6 +433,8 @@ void Screen::resetDisplay(bool resetVideo, bool noShaders)
 		}
 	}
 	SDL_SetColorKey(_surface.get(), 0, 0); // turn off color key!
+	_prevFrame.clear();
+	_redrawAll = true;
 
 	if (resetVideo || _screen->format->BitsPerPixel != _bpp)
 	{
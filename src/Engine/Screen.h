@@ -19,6 +19,7 @@
  */
 #include <SDL.h>
 #include <string>
+#include <vector>
 #include "OpenGL.h"
 #include "Surface.h"
 
@@ -52,6 +53,10 @@ private:
 	OpenGL glOutput;
 	Surface::UniqueBufferPtr _buffer;
 	Surface::UniqueSurfacePtr _surface;
+	std::vector<Uint8> _prevFrame;
+	bool _redrawAll;
+	/// Finds the rows of the buffer that changed since the last flip.
+	bool getDirtyRows(int &firstRow, int &lastRow);
 	/// Sets the _flags and _bpp variables based on game options; needed in more than one place now
 	void makeVideoFlags();
 public:
@@ -74,6 +79,8 @@ public:
 	void flip();
 	/// Clears the screen.
 	void clear();
+	/// Forces the next flip to redraw the whole screen.
+	void invalidate();
 	/// Sets the screen's 8bpp palette.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256, bool immediately = false);
 	/// Gets the screen's 8bpp palette.
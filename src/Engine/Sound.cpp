@@ -17,6 +17,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Sound.h"
+#include <algorithm>
+#include <cstdlib>
 #include "Options.h"
 #include "Logger.h"
 #include "Unicode.h"
@@ -25,6 +27,35 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// What a mixer channel was last asked to play.
+struct ChannelState
+{
+	const Sound *sound = nullptr;
+	Uint32 frame = 0;
+	int angle = 0, distance = 0;
+	bool limited = false;
+};
+
+std::vector<ChannelState> channelStates;
+Uint32 currentFrame = 1;
+size_t pannedBytes = 0;
+const size_t MAX_PANNED_BYTES = 16 * 1024 * 1024;
+
+/**
+ * Gets how far a sound is from the listener,
+ * the farthest voices are the first ones dropped.
+ */
+int getSoundDistance(int angle, int distance)
+{
+	angle = std::abs(angle) % 360;
+	return std::min(angle, 360 - angle) + (Uint8)distance;
+}
+
+}
+
 /**
  * Deletes the loaded sound content.
  */
@@ -51,9 +82,57 @@ void Sound::load(const std::string &filename) {
 	}
 
 	//always overwrite
+	clearPanned();
 	_sound = std::move(s);
 }
 
+/**
+ * Cleans up the sound effect and its panned copies.
+ */
+Sound::~Sound()
+{
+	clearPanned();
+}
+
+/**
+ * Takes over the sound and its panned copies.
+ * @param other Sound to move from.
+ */
+Sound::Sound(Sound&& other) : _sound(std::move(other._sound)), _panned(std::move(other._panned))
+{
+	other._panned.clear();
+}
+
+/**
+ * Frees the current sound and its panned copies,
+ * then takes over the other ones.
+ * @param other Sound to move from.
+ * @return This sound.
+ */
+Sound& Sound::operator=(Sound&& other)
+{
+	if (this != &other)
+	{
+		clearPanned();
+		_sound = std::move(other._sound);
+		_panned = std::move(other._panned);
+		other._panned.clear();
+	}
+	return *this;
+}
+
+/**
+ * Frees the panned copies of the sound.
+ */
+void Sound::clearPanned()
+{
+	if (_sound)
+	{
+		pannedBytes -= _panned.size() * _sound->alen;
+	}
+	_panned.clear();
+}
+
 /**
  * Loads a sound file from a specified rwops.
  * @param rw SDL_RWops of the sound data.
@@ -66,6 +145,7 @@ void Sound::load(SDL_RWops *rw) {
 	}
 
 	//always overwrite
+	clearPanned();
 	_sound = std::move(s);
 }
 
@@ -74,24 +154,207 @@ void Sound::load(SDL_RWops *rw) {
  * @param channel Use specified channel, -1 to use any channel
  */
 void Sound::play(int channel, int angle, int distance) const
+{
+	playChannel(channel, angle, distance, false);
+}
+
+/**
+ * Plays a sound effect of the battle on any channel. The same sound
+ * at the same position is played once per frame and only gets a few
+ * voices at once, interface sounds are left alone.
+ * @param angle Angle of the sound.
+ * @param distance Distance of the sound.
+ */
+void Sound::playInBattle(int angle, int distance) const
+{
+	playChannel(-1, angle, distance, true);
+}
+
+/**
+ * Plays the contained sound effect.
+ * @param channel Use specified channel, -1 to use any channel
+ * @param angle Angle of the sound.
+ * @param distance Distance of the sound.
+ * @param limitVoices Apply the voice limit of battle sounds.
+ */
+void Sound::playChannel(int channel, int angle, int distance, bool limitVoices) const
  {
 	if (!Options::mute && _sound)
  	{
-		int chan = Mix_PlayChannel(channel, _sound.get(), 0);
+		if (limitVoices && !getVoice(channel, angle, distance))
+		{
+			return;
+		}
+		Mix_Chunk *panned = Options::StereoSound ? getPanned(angle, distance) : 0;
+		int chan = Mix_PlayChannel(channel, panned ? panned : _sound.get(), 0);
 		if (chan == -1)
 		{
 			Log(LOG_WARNING) << Mix_GetError();
+			return;
 		}
-		else if (Options::StereoSound)
+		else if (Options::StereoSound && !panned)
 		{
 			if (!Mix_SetPosition(chan, angle, distance))
 			{
 				Log(LOG_WARNING) << Mix_GetError();
 			}
 		}
+		if ((size_t)chan >= channelStates.size())
+		{
+			channelStates.resize(chan + 1);
+		}
+		ChannelState &state = channelStates[chan];
+		state.sound = this;
+		state.frame = currentFrame;
+		state.angle = angle;
+		state.distance = distance;
+		state.limited = limitVoices;
 	}
 }
 
+/**
+ * Decides where a sound goes when too many are playing: the same sound
+ * at the same position is only played once per frame, and a sound only
+ * gets a few voices at once, the farthest ones giving way to closer ones.
+ * When the mixer is out of channels the farthest sound is replaced.
+ * @param channel Channel requested, -1 for any, replaced by the channel to use.
+ * @param angle Angle of the sound.
+ * @param distance Distance of the sound.
+ * @return False if the sound shouldn't be played.
+ */
+bool Sound::getVoice(int &channel, int angle, int distance) const
+{
+	if (Options::oxceSoundVoiceLimit <= 0 || channel != -1)
+	{
+		return true;
+	}
+	int priority = getSoundDistance(angle, distance);
+	int voices = 0;
+	int farthestVoice = -1, farthestVoiceDistance = priority;
+	int farthest = -1, farthestDistance = priority;
+	for (size_t i = 0; i < channelStates.size(); ++i)
+	{
+		const ChannelState &state = channelStates[i];
+		if (!state.sound || !state.limited || !Mix_Playing(i))
+		{
+			continue;
+		}
+		int d = getSoundDistance(state.angle, state.distance);
+		if (state.sound == this)
+		{
+			if (state.frame == currentFrame && state.angle == angle && state.distance == distance)
+			{
+				return false;
+			}
+			++voices;
+			if (d > farthestVoiceDistance)
+			{
+				farthestVoice = i;
+				farthestVoiceDistance = d;
+			}
+		}
+		if (d > farthestDistance)
+		{
+			farthest = i;
+			farthestDistance = d;
+		}
+	}
+	if (voices >= Options::oxceSoundVoiceLimit)
+	{
+		if (farthestVoice == -1)
+		{
+			return false;
+		}
+		channel = farthestVoice;
+	}
+	else if (Mix_GroupAvailable(-1) == -1)
+	{
+		if (farthest == -1)
+		{
+			return false;
+		}
+		channel = farthest;
+	}
+	if (channel != -1)
+	{
+		Mix_HaltChannel(channel);
+	}
+	return true;
+}
+
+/**
+ * Gets a copy of the sound with the stereo panning of Mix_SetPosition
+ * already applied, so the mixer doesn't have to pan it on every play.
+ * Only done for the usual 16-bit stereo output.
+ * @param angle Angle of the sound.
+ * @param distance Distance of the sound.
+ * @return Panned sound, or 0 if the mixer has to pan it.
+ */
+Mix_Chunk *Sound::getPanned(int angle, int distance) const
+{
+	int frequency, channels;
+	Uint16 format;
+	if (!Mix_QuerySpec(&frequency, &format, &channels) || format != AUDIO_S16SYS || channels != 2)
+	{
+		return 0;
+	}
+	// same normalization as Mix_SetPosition
+	angle %= 360;
+	if (angle < 0)
+	{
+		angle += 360;
+	}
+	distance = (Uint8)distance;
+	if (angle == 0 && distance == 0)
+	{
+		return _sound.get();
+	}
+	int key = angle * 256 + distance;
+	auto it = _panned.find(key);
+	if (it != _panned.end())
+	{
+		return it->second.chunk.get();
+	}
+	if (pannedBytes + _sound->alen > MAX_PANNED_BYTES)
+	{
+		return 0;
+	}
+
+	// set_amplitudes() of SDL_mixer's position effect: the head occludes the far side,
+	// so 90 (east) mutes the left speaker and 270 (west) the right one
+	int left = 255, right = 255;
+	if (angle < 90)
+		left = 255 - (int)(255.0f * (angle / 89.0f));
+	else if (angle < 180)
+		left = (int)(255.0f * ((angle - 90) / 89.0f));
+	else if (angle < 270)
+		right = 255 - (int)(255.0f * ((angle - 180) / 89.0f));
+	else
+		right = (int)(255.0f * ((angle - 270) / 89.0f));
+	float leftVolume = left / 255.0f;
+	float rightVolume = right / 255.0f;
+	float distanceVolume = (255 - distance) / 255.0f;
+
+	PannedSound &panned = _panned[key];
+	panned.data.resize(_sound->alen);
+	const Sint16 *src = (const Sint16*)_sound->abuf;
+	Sint16 *dst = (Sint16*)panned.data.data();
+	for (Uint32 i = 0; i + 1 < _sound->alen / sizeof(Sint16); i += 2)
+	{
+		dst[i] = (Sint16)((src[i] * leftVolume) * distanceVolume);
+		dst[i + 1] = (Sint16)((src[i + 1] * rightVolume) * distanceVolume);
+	}
+	panned.chunk = NewSound(Mix_QuickLoad_RAW(panned.data.data(), _sound->alen));
+	if (!panned.chunk)
+	{
+		_panned.erase(key);
+		return 0;
+	}
+	panned.chunk->volume = _sound->volume;
+	pannedBytes += _sound->alen;
+	return panned.chunk.get();
+}
+
 /**
  * Stops all sounds playing.
  */
@@ -103,6 +366,15 @@ void Sound::stop()
 	}
 }
 
+/**
+ * Starts a new frame, repeats of a sound at the same
+ * position are dropped until the next one.
+ */
+void Sound::newFrame()
+{
+	++currentFrame;
+}
+
 /**
  * Plays the contained sound effect repeatedly on the reserved ambience channel.
  */
@@ -21,6 +21,8 @@
 #include <SDL_mixer.h>
 #include <string>
 #include <memory>
+#include <map>
+#include <vector>
 
 namespace OpenXcom
 {
@@ -43,17 +45,34 @@ public:
 	static UniqueSoundPtr NewSound(Mix_Chunk* sound);
 
 private:
+	/// Copy of the sound with the stereo panning already applied.
+	struct PannedSound
+	{
+		std::vector<Uint8> data;
+		UniqueSoundPtr chunk;
+	};
+
 	UniqueSoundPtr _sound;
+	mutable std::map<int, PannedSound> _panned;
+
+	/// Gets a copy of the sound panned to a position.
+	Mix_Chunk *getPanned(int angle, int distance) const;
+	/// Frees the panned copies of the sound.
+	void clearPanned();
+	/// Picks the channel to play the sound on.
+	bool getVoice(int &channel, int angle, int distance) const;
+	/// Plays the sound, optionally sharing the voices with other battle sounds.
+	void playChannel(int channel, int angle, int distance, bool limitVoices) const;
 
 public:
 	/// Creates a blank sound effect.
 	Sound() = default;
 	/// Cleans up the sound effect.
-	~Sound() = default;
+	~Sound();
 	/// Move sound to another place.
-	Sound(Sound&& other) = default;
+	Sound(Sound&& other);
 	/// Move assignment
-	Sound& operator=(Sound&& other) = default;
+	Sound& operator=(Sound&& other);
 
 	/// Loads sound from the specified file.
 	void load(const std::string &filename);
@@ -61,8 +80,12 @@ public:
 	void load(SDL_RWops *rw);
 	/// Plays the sound.
 	void play(int channel = -1, int angle = 0, int distance = 0) const;
+	/// Plays a sound of the battle, within the voice limits.
+	void playInBattle(int angle = 0, int distance = 0) const;
 	/// Stops all sounds.
 	static void stop();
+	/// Starts a new frame, identical sounds are played once per frame.
+	static void newFrame();
 	/// Plays the sound repeatedly.
 	void loop();
 	/// Stops the looping sound effect.
@@ -29,6 +29,7 @@
 #include "Logger.h"
 #include "SDL2Helpers.h"
 #include "FileMap.h"
+#include "PaletteConverter.h"
 #ifdef _WIN32
 #include <malloc.h>
 #endif
@@ -705,6 +706,13 @@ void Surface::blit(SDL_Surface *surface)
 		if (_redraw)
 			draw();
 
+		if (_surface->format->BitsPerPixel == 8 && surface->format->BitsPerPixel == 32 && _surface->format->palette && _surface->format->palette->ncolors == 256)
+		{
+			// 32bpp screen buffer used by OpenGL and the 32bit scalers
+			PaletteConverter::blit(_surface.get(), nullptr, surface, getX(), getY());
+			return;
+		}
+
 		SDL_Rect target {};
 		target.x = getX();
 		target.y = getY();
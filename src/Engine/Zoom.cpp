@@ -18,6 +18,7 @@
  */
 
 #include "Zoom.h"
+#include <algorithm>
 
 #include "Surface.h"
 #include "Logger.h"
@@ -657,6 +658,9 @@ bool Zoom::haveSSE2()
  * Wrapper around various software and OpenGL screen buffer pushing functions which zoom.
  * Basically called just from Screen::flip()
  *
+ * Only the source rows in [srcFirstRow, srcLastRow) are guaranteed to be pushed,
+ * the rest of the destination is expected to still hold the previous frame.
+ *
  * @param src The surface to zoom (input).
  * @param dst The zoomed surface (output).
  * @param topBlackBand Size of top black band in pixels (letterboxing).
@@ -664,17 +668,27 @@ bool Zoom::haveSSE2()
  * @param leftBlackBand Size of left black band in pixels (letterboxing).
  * @param rightBlackBand Size of right black band in pixels (letterboxing).
  * @param glOut OpenGL output.
+ * @param srcFirstRow First changed row of the source.
+ * @param srcLastRow One past the last changed row of the source.
  */
-void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, OpenGL *glOut)
+void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, OpenGL *glOut, int srcFirstRow, int srcLastRow)
 {
 	int dstWidth = dst->w - leftBlackBand - rightBlackBand;
 	int dstHeight = dst->h - topBlackBand - bottomBlackBand;
+	srcFirstRow = std::max(srcFirstRow, 0);
+	srcLastRow = std::min(srcLastRow, src->h);
+	if (srcFirstRow >= srcLastRow)
+	{
+		return;
+	}
 	if (Screen::useOpenGL())
 	{
 #ifndef __NO_OPENGL
 		if (glOut->buffer_surface)
 		{
-			SDL_BlitSurface(src, 0, glOut->surface.get(), 0); // TODO; this is less than ideal...
+			SDL_Rect band = {0, (Sint16)srcFirstRow, (Uint16)src->w, (Uint16)(srcLastRow - srcFirstRow)};
+			SDL_Rect bandDst = band;
+			SDL_BlitSurface(src, &band, glOut->surface.get(), &bandDst); // TODO; this is less than ideal...
 
 			glOut->refresh(glOut->linear, glOut->iwidth, glOut->iheight, dst->w, dst->h, topBlackBand, bottomBlackBand, leftBlackBand, rightBlackBand);
 			SDL_GL_SwapBuffers();
@@ -683,27 +697,133 @@ void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, in
 	}
 	else if (topBlackBand <= 0 && bottomBlackBand <= 0 && leftBlackBand <= 0 && rightBlackBand <= 0)
 	{
-		_zoomSurfaceY(src, dst, 0, 0);
+		_zoomSurfaceY(src, dst, 0, 0, srcFirstRow, srcLastRow);
 	}
 	else if (dstWidth == src->w && dstHeight == src->h)
 	{
-		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)topBlackBand, (Uint16)src->w, (Uint16)src->h};
-		SDL_BlitSurface(src, NULL, dst, &dstrect);
+		SDL_Rect band = {0, (Sint16)srcFirstRow, (Uint16)src->w, (Uint16)(srcLastRow - srcFirstRow)};
+		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)(topBlackBand + srcFirstRow), (Uint16)src->w, (Uint16)(srcLastRow - srcFirstRow)};
+		SDL_BlitSurface(src, &band, dst, &dstrect);
 	}
 	else
 	{
 		SDL_Surface *tmp = SDL_CreateRGBSurface(dst->flags, dstWidth, dstHeight, dst->format->BitsPerPixel, 0, 0, 0, 0);
-		_zoomSurfaceY(src, tmp, 0, 0);
+		_zoomSurfaceY(src, tmp, 0, 0, srcFirstRow, srcLastRow);
 		if (src->format->palette != NULL)
 		{
 			SDL_SetPalette(tmp, SDL_LOGPAL|SDL_PHYSPAL, src->format->palette->colors, 0, src->format->palette->ncolors);
 		}
-		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)topBlackBand, (Uint16)tmp->w, (Uint16)tmp->h};
-		SDL_BlitSurface(tmp, NULL, dst, &dstrect);
+		int tmpFirstRow = 0, tmpLastRow = tmp->h;
+		if (canZoomRows(src->w, src->h, tmp->w, tmp->h))
+		{
+			getZoomedRows(src->w, src->h, tmp->w, tmp->h, srcFirstRow, srcLastRow, tmpFirstRow, tmpLastRow);
+		}
+		SDL_Rect band = {0, (Sint16)tmpFirstRow, (Uint16)tmp->w, (Uint16)(tmpLastRow - tmpFirstRow)};
+		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)(topBlackBand + tmpFirstRow), (Uint16)tmp->w, (Uint16)(tmpLastRow - tmpFirstRow)};
+		SDL_BlitSurface(tmp, &band, dst, &dstrect);
 		SDL_FreeSurface(tmp);
 	}
 }
 
+/**
+ * Calculates which destination rows the zoom fills
+ * from the given range of source rows.
+ * xBRZ reads two rows around each source row, so its range is widened
+ * by that margin. Otherwise the same stepping as the nearest neighbour
+ * zoom in _zoomSurfaceY() is used, so the results match exactly.
+ * @param srcWidth Width of the source surface.
+ * @param srcHeight Height of the source surface.
+ * @param dstWidth Width of the destination surface.
+ * @param dstHeight Height of the destination surface.
+ * @param srcFirstRow First source row.
+ * @param srcLastRow One past the last source row.
+ * @param dstFirstRow Returns the first destination row.
+ * @param dstLastRow Returns one past the last destination row.
+ */
+void Zoom::getZoomedRows(int srcWidth, int srcHeight, int dstWidth, int dstHeight, int srcFirstRow, int srcLastRow, int &dstFirstRow, int &dstLastRow)
+{
+	int factor = getXBRZFactor(srcWidth, srcHeight, dstWidth, dstHeight);
+	if (factor)
+	{
+		dstFirstRow = std::max(srcFirstRow - 2, 0) * factor;
+		dstLastRow = std::min(srcLastRow + 2, srcHeight) * factor;
+		return;
+	}
+	dstFirstRow = dstHeight;
+	dstLastRow = dstHeight;
+	int row = 0;
+	int csy = 0;
+	for (int y = 0; y < dstHeight; y++)
+	{
+		if (row >= srcLastRow)
+		{
+			dstLastRow = y;
+			break;
+		}
+		if (row >= srcFirstRow && dstFirstRow == dstHeight)
+		{
+			dstFirstRow = y;
+		}
+		csy += srcHeight;
+		while (csy >= dstHeight)
+		{
+			csy -= dstHeight;
+			row++;
+		}
+	}
+	if (dstFirstRow > dstLastRow)
+	{
+		dstFirstRow = dstLastRow;
+	}
+}
+
+/**
+ * Checks if the zoom between surfaces of the given sizes
+ * can redraw only some rows and leave the others as they are.
+ * HQX and the scale2x filters always redraw the whole surface.
+ * @param srcWidth Width of the source surface.
+ * @param srcHeight Height of the source surface.
+ * @param dstWidth Width of the destination surface.
+ * @param dstHeight Height of the destination surface.
+ * @return True if a range of rows can be redrawn.
+ */
+bool Zoom::canZoomRows(int srcWidth, int srcHeight, int dstWidth, int dstHeight)
+{
+	if (Options::useScaleFilter)
+	{
+		return false;
+	}
+	if (Screen::use32bitScaler())
+	{
+		return getXBRZFactor(srcWidth, srcHeight, dstWidth, dstHeight) != 0;
+	}
+	return true;
+}
+
+/**
+ * Gets the factor _zoomSurfaceY() runs xBRZ with
+ * between surfaces of the given sizes.
+ * @param srcWidth Width of the source surface.
+ * @param srcHeight Height of the source surface.
+ * @param dstWidth Width of the destination surface.
+ * @param dstHeight Height of the destination surface.
+ * @return The factor, or 0 if xBRZ isn't used.
+ */
+int Zoom::getXBRZFactor(int srcWidth, int srcHeight, int dstWidth, int dstHeight)
+{
+	if (Screen::use32bitScaler() && Options::useXBRZFilter)
+	{
+		for (int factor = 2; factor <= 6; factor++)
+		{
+			if (dstWidth == srcWidth * factor && dstHeight == srcHeight * factor)
+			{
+				return factor;
+			}
+		}
+	}
+	return 0;
+}
+
 
 /**
  * Internal 8-bit Zoomer without smoothing.
@@ -717,31 +837,33 @@ void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, in
  * @param dst The zoomed surface (output).
  * @param flipx Flag indicating if the image should be horizontally flipped.
  * @param flipy Flag indicating if the image should be vertically flipped.
+ * @param srcFirstRow First source row that needs to be zoomed.
+ * @param srcLastRow One past the last source row that needs to be zoomed.
  * @return 0 for success or -1 for error.
  */
-int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int flipy)
+int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int flipy, int srcFirstRow, int srcLastRow)
 {
 	int x, y;
 	static Uint32 *sax, *say;
 	Uint32 *csax, *csay;
 	int csx, csy;
+	int srow;
 	Uint8 *sp, *dp, *csp;
 	int dgap;
 	static bool proclaimed = false;
 
+	srcFirstRow = std::max(srcFirstRow, 0);
+	srcLastRow = std::min(srcLastRow, src->h);
+
 	if (Screen::use32bitScaler())
 	{
-		if (Options::useXBRZFilter)
+		// check the resolution to see which scale we need
+		int factor = getXBRZFactor(src->w, src->h, dst->w, dst->h);
+		if (factor)
 		{
-			// check the resolution to see which scale we need
-			for (size_t factor = 2; factor <= 6; factor++)
-			{
-				if (dst->w == src->w * (int)factor && dst->h == src->h * (int)factor)
-				{
-					xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB);
-					return 0;
-				}
-			}
+			// xBRZ looks two rows around each changed row
+			xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB, xbrz::ScalerCfg(), std::max(srcFirstRow - 2, 0), std::min(srcLastRow + 2, src->h));
+			return 0;
 		}
 
 		if (Options::useHQXFilter)
@@ -897,7 +1019,15 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 	* Draw
 	*/
 	csay = say;
+	srow = flipy ? src->h - 1 : 0;
 	for (y = 0; y < dst->h; y++) {
+		if (srow < srcFirstRow || srow >= srcLastRow) {
+			/*
+			* Row unchanged, skip it
+			*/
+			dp += dst->w;
+		}
+		else {
 		csax = sax;
 		sp = csp;
 		for (x = 0; x < dst->w; x++) {
@@ -915,10 +1045,12 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 			*/
 			dp++;
 		}
+		}
 		/*
 		* Advance source pointer (for row)
 		*/
 		csp += (*csay);
+		srow += (int)(*csay) / src->pitch;
 		csay++;
 
 		/*
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <SDL.h>
+#include <climits>
 #include "OpenGL.h"
 
 namespace OpenXcom
@@ -29,9 +30,15 @@ class Zoom
 
 	public:
 	/// Flip screen given src and dst; might use software or OpenGL.
-	static void flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, OpenGL *glOut);
+	static void flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, OpenGL *glOut, int srcFirstRow = 0, int srcLastRow = INT_MAX);
 	/// Copy src to dst, resizing as needed. Please don't use flipx or flipy as the optimized functions ignore these parameters.
-	static int _zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int flipy);
+	static int _zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int flipy, int srcFirstRow = 0, int srcLastRow = INT_MAX);
+	/// Gets the range of destination rows that the zoom fills from the given source rows.
+	static void getZoomedRows(int srcWidth, int srcHeight, int dstWidth, int dstHeight, int srcFirstRow, int srcLastRow, int &dstFirstRow, int &dstLastRow);
+	/// Checks if the zoom between surfaces of the given sizes can redraw only some rows.
+	static bool canZoomRows(int srcWidth, int srcHeight, int dstWidth, int dstHeight);
+	/// Gets the xBRZ factor used between surfaces of the given sizes.
+	static int getXBRZFactor(int srcWidth, int srcHeight, int dstWidth, int dstHeight);
 	/// Check for SSE2 instructions using CPUID.
 	static bool haveSSE2();
 
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DogfightBenchmark.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <SDL.h>
+#include <SDL_thread.h>
+#include "DogfightSimulator.h"
+#include "../Engine/Logger.h"
+#include "../Mod/Mod.h"
+#include "../Mod/RuleCraft.h"
+#include "../Mod/RuleCraftWeapon.h"
+#include "../Mod/RuleUfo.h"
+
+namespace OpenXcom
+{
+
+namespace DogfightBenchmark
+{
+
+namespace
+{
+
+/// Totals of a batch of simulated interceptions.
+struct Totals
+{
+	int runs = 0;
+	int outcomes[DFO_TIMEOUT + 1] = { };
+	int craftLost = 0;
+	long long craftDamageTaken = 0, ufoDamageDealt = 0;
+	long long shotsFired = 0, shotsHit = 0, ammoUsed = 0, ticks = 0;
+
+	void add(const DogfightResult &r)
+	{
+		runs++;
+		outcomes[r.outcome]++;
+		craftLost += r.craftDestroyed ? 1 : 0;
+		craftDamageTaken += r.craftDamageTaken;
+		ufoDamageDealt += r.ufoDamageDealt;
+		shotsFired += r.shotsFired;
+		shotsHit += r.shotsHit;
+		ammoUsed += r.ammoUsed;
+		ticks += r.ticks;
+	}
+	void add(const Totals &t)
+	{
+		runs += t.runs;
+		for (int i = 0; i <= DFO_TIMEOUT; ++i)
+			outcomes[i] += t.outcomes[i];
+		craftLost += t.craftLost;
+		craftDamageTaken += t.craftDamageTaken;
+		ufoDamageDealt += t.ufoDamageDealt;
+		shotsFired += t.shotsFired;
+		shotsHit += t.shotsHit;
+		ammoUsed += t.ammoUsed;
+		ticks += t.ticks;
+	}
+};
+
+/// Work for one thread: a range of run indices.
+struct Batch
+{
+	Mod *mod;
+	const DogfightSetup *setup;
+	uint64_t seed;
+	int first, last;
+	Totals totals;
+};
+
+/**
+ * Derives a well mixed, non-zero seed for a run (splitmix64),
+ * so results don't depend on how runs are split across threads.
+ */
+uint64_t runSeed(uint64_t seed, int run)
+{
+	uint64_t z = seed + 0x9e3779b97f4a7c15ull * (uint64_t)(run + 1);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	z = z ^ (z >> 31);
+	return z ? z : 1;
+}
+
+/**
+ * Thread entry point, simulates a batch of runs.
+ */
+int runBatch(void *data)
+{
+	Batch *batch = (Batch*)data;
+	for (int i = batch->first; i < batch->last; ++i)
+	{
+		RNG::RandomState random(runSeed(batch->seed, i));
+		DogfightSimulator sim(batch->mod, *batch->setup, random);
+		batch->totals.add(sim.run());
+	}
+	return 0;
+}
+
+/**
+ * Splits a string on a delimiter.
+ */
+std::vector<std::string> split(const std::string &s, char delimiter)
+{
+	std::vector<std::string> parts;
+	std::istringstream ss(s);
+	std::string part;
+	while (std::getline(ss, part, delimiter))
+	{
+		parts.push_back(part);
+	}
+	return parts;
+}
+
+}
+
+/**
+ * Parses a spec of the form CRAFT:WEAPON,...:UFO[:RUNS[:MODE[:DIFFICULTY[:SEED]]]],
+ * simulates the interceptions on all cores and prints the statistics
+ * to the standard output and the log.
+ * @param mod Pointer to the loaded mod.
+ * @param spec Benchmark description from the command line.
+ * @return True if the benchmark ran.
+ */
+bool run(Mod *mod, const std::string &spec)
+{
+	std::vector<std::string> args = split(spec, ':');
+	if (args.size() < 3)
+	{
+		Log(LOG_ERROR) << "Dogfight benchmark: expected CRAFT:WEAPON,...:UFO[:RUNS[:MODE[:DIFFICULTY[:SEED]]]], got '" << spec << "'";
+		return false;
+	}
+	const RuleCraft *craft = mod->getCraft(args[0]);
+	const RuleUfo *ufo = mod->getUfo(args[2]);
+	if (!craft || !ufo)
+	{
+		Log(LOG_ERROR) << "Dogfight benchmark: unknown craft '" << args[0] << "' or UFO '" << args[2] << "'";
+		return false;
+	}
+	std::vector<const RuleCraftWeapon*> weapons;
+	for (const auto &name : split(args[1], ','))
+	{
+		const RuleCraftWeapon *weapon = name.empty() ? nullptr : mod->getCraftWeapon(name);
+		if (!weapon && !name.empty())
+		{
+			Log(LOG_ERROR) << "Dogfight benchmark: unknown craft weapon '" << name << "'";
+			return false;
+		}
+		weapons.push_back(weapon);
+	}
+	int runs = args.size() > 3 ? std::max(1, atoi(args[3].c_str())) : 10000;
+	DogfightSimulationMode mode = DSM_STANDARD;
+	if (args.size() > 4 && !args[4].empty())
+	{
+		if (args[4] == "cautious")
+			mode = DSM_CAUTIOUS;
+		else if (args[4] == "standard")
+			mode = DSM_STANDARD;
+		else if (args[4] == "aggressive")
+			mode = DSM_AGGRESSIVE;
+		else
+		{
+			Log(LOG_ERROR) << "Dogfight benchmark: unknown mode '" << args[4] << "', expected cautious, standard or aggressive";
+			return false;
+		}
+	}
+	int difficulty = args.size() > 5 ? std::max(0, std::min(4, atoi(args[5].c_str()))) : 0;
+	uint64_t seed = args.size() > 6 ? strtoull(args[6].c_str(), nullptr, 10) : 0;
+
+	DogfightSetup setup = DogfightSimulator::setupFromRules(craft, weapons, ufo, difficulty, mode);
+
+	int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+	threads = std::min(threads, runs);
+	std::vector<Batch> batches(threads);
+	std::vector<SDL_Thread*> handles(threads, nullptr);
+	Uint32 start = SDL_GetTicks();
+	for (int t = 0; t < threads; ++t)
+	{
+		Batch &b = batches[t];
+		b.mod = mod;
+		b.setup = &setup;
+		b.seed = seed;
+		b.first = (int)((long long)runs * t / threads);
+		b.last = (int)((long long)runs * (t + 1) / threads);
+		handles[t] = t > 0 ? SDL_CreateThread(runBatch, &b) : nullptr;
+	}
+	runBatch(&batches[0]);
+	Totals totals;
+	for (int t = 0; t < threads; ++t)
+	{
+		if (t > 0)
+		{
+			if (handles[t])
+				SDL_WaitThread(handles[t], nullptr);
+			else
+				runBatch(&batches[t]); // couldn't create the thread, do it here
+		}
+		totals.add(batches[t].totals);
+	}
+	Uint32 elapsed = SDL_GetTicks() - start;
+
+	auto percent = [&](int count) { return 100.0 * count / totals.runs; };
+	auto average = [&](long long sum) { return (double)sum / totals.runs; };
+	int wins = totals.outcomes[DFO_UFO_CRASHED] + totals.outcomes[DFO_UFO_DESTROYED] + totals.outcomes[DFO_UFO_FORCED_DOWN];
+
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	ss << "Dogfight benchmark: " << args[0] << " [" << args[1] << "] vs " << args[2] << ", " << totals.runs << " runs, " << threads << " threads, " << elapsed << " ms\n";
+	ss << "  win rate:           " << percent(wins) << "%"
+		<< " (crashed " << percent(totals.outcomes[DFO_UFO_CRASHED])
+		<< "%, destroyed " << percent(totals.outcomes[DFO_UFO_DESTROYED])
+		<< "%, forced down " << percent(totals.outcomes[DFO_UFO_FORCED_DOWN]) << "%)\n";
+	ss << "  craft lost:         " << percent(totals.craftLost) << "%\n";
+	ss << "  UFO escaped:        " << percent(totals.outcomes[DFO_UFO_ESCAPED]) << "%\n";
+	ss << "  timed out:          " << percent(totals.outcomes[DFO_TIMEOUT]) << "%\n";
+	ss << "  avg damage taken:   " << average(totals.craftDamageTaken) << " / " << setup.craftStats.damageMax << "\n";
+	ss << "  avg damage dealt:   " << average(totals.ufoDamageDealt) << " / " << setup.ufoStats.damageMax << "\n";
+	ss << "  avg ammo used:      " << average(totals.ammoUsed) << " (hit rate " << (totals.shotsFired ? 100.0 * totals.shotsHit / totals.shotsFired : 0.0) << "%)\n";
+	ss << "  avg length (ticks): " << average(totals.ticks) << "\n";
+	std::cout << ss.str();
+	Log(LOG_INFO) << ss.str();
+	return true;
+}
+
+}
+
+}
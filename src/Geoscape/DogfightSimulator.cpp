@@ -0,0 +1,1071 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DogfightSimulator.h"
+#include <algorithm>
+#include <cmath>
+#include "../Mod/Mod.h"
+#include "../Mod/RuleCraftWeapon.h"
+#include "../Mod/RuleUfo.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/CraftWeapon.h"
+#include "../Savegame/Soldier.h"
+#include "../Savegame/Ufo.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Copies the values a UFO shares with all the interceptions it is in.
+ * @param setup Setup to fill.
+ * @param ufo Pointer to the UFO.
+ */
+void readUfo(DogfightSetup &setup, const Ufo *ufo)
+{
+	setup.ufoDamage = ufo->getDamage();
+	setup.ufoShield = ufo->getShield();
+	setup.ufoSpeed = ufo->getSpeed();
+	setup.ufoEscapeCountdown = ufo->getEscapeCountdown();
+	setup.ufoFireCountdown = ufo->getFireCountdown();
+	setup.ufoTractorBeamSlowdown = ufo->getTractorBeamSlowdown();
+	setup.ufoHunterKiller = ufo->isHunterKiller();
+	setup.ufoSoftlockShotCounter = ufo->getSoftlockShotCounter();
+	setup.ufoInterceptionProcessed = ufo->getInterceptionProcessed();
+	setup.ufoShootingAt = ufo->getShootingAt();
+	setup.ufoShieldRechargeHandle = ufo->getShieldRechargeHandle();
+}
+
+}
+
+/**
+ * Builds the setup of a fresh interception from rules only:
+ * undamaged craft with full ammo and shields, no pilots, and
+ * a UFO cruising below the craft's top speed until it breaks off.
+ * @param craft Craft rules.
+ * @param weapons Weapon rules per slot (null for empty slots).
+ * @param ufo UFO rules.
+ * @param difficulty Game difficulty.
+ * @param mode Attack mode to fly.
+ * @return Setup of the interception.
+ */
+DogfightSetup DogfightSimulator::setupFromRules(const RuleCraft *craft, const std::vector<const RuleCraftWeapon*> &weapons, const RuleUfo *ufo, int difficulty, DogfightSimulationMode mode)
+{
+	DogfightSetup setup;
+	setup.craftStats = craft->getStats();
+	setup.missileCraft = craft->isMissile();
+	setup.missilePower = craft->missilePower();
+
+	int weaponNum = std::min(craft->getWeapons(), RuleCraft::WeaponMax);
+	setup.weapons.resize(weaponNum);
+	for (int i = 0; i < weaponNum && i < (int)weapons.size(); ++i)
+	{
+		if (weapons[i])
+		{
+			setup.weapons[i].rules = weapons[i];
+			setup.weapons[i].ammo = weapons[i]->getAmmoMax();
+			setup.craftStats += weapons[i]->getBonusStats();
+		}
+	}
+	setup.craftShield = setup.craftStats.shieldCapacity;
+
+	setup.ufoRules = ufo;
+	setup.ufoStats = ufo->getStats();
+	setup.ufoShield = setup.ufoStats.shieldCapacity;
+	setup.ufoNeverCrashLands = ufo->isUnmanned();
+
+	setup.difficulty = difficulty;
+	setup.mode = mode;
+	if (setup.missileCraft)
+	{
+		// approach UFO at maximum approach speed
+		setup.cannotDisengage = true;
+		setup.pilotApproachSpeedModifier = 4;
+		setup.mode = DSM_AGGRESSIVE;
+	}
+	return setup;
+}
+
+/**
+ * Builds the setup of an interception from the game, the way
+ * DogfightState starts one: pilot bonuses, the hunter-killer's
+ * choice of target and the values the UFO shares with other
+ * interceptions. Pilot stats must already include their bonuses.
+ * @param mod Pointer to the mod.
+ * @param craft Pointer to the craft intercepting.
+ * @param ufo Pointer to the UFO being intercepted.
+ * @param ufoIsAttacking Is the UFO the aggressor?
+ * @param difficulty Game difficulty.
+ * @return Setup of the interception.
+ */
+DogfightSetup DogfightSimulator::setupFromGame(const Mod *mod, Craft *craft, Ufo *ufo, bool ufoIsAttacking, int difficulty)
+{
+	DogfightSetup setup;
+	setup.craftStats = craft->getCraftStats();
+	setup.craftDamage = craft->getDamage();
+	setup.craftShield = craft->getShield();
+	setup.missileCraft = craft->getRules()->isMissile();
+	setup.missilePower = craft->getRules()->missilePower();
+
+	int weaponNum = std::min(craft->getRules()->getWeapons(), RuleCraft::WeaponMax);
+	setup.weapons.resize(weaponNum);
+	for (int i = 0; i < weaponNum; ++i)
+	{
+		CraftWeapon *w = craft->getWeapons()->at(i);
+		if (w)
+		{
+			setup.weapons[i].rules = w->getRules();
+			setup.weapons[i].ammo = w->getAmmo();
+			setup.weapons[i].enabled = !w->isDisabled();
+		}
+	}
+
+	const std::vector<Soldier*> pilots = craft->getPilotList(false);
+	setup.pilotAccuracyBonus = craft->getPilotAccuracyBonus(pilots, mod);
+	setup.pilotDodgeBonus = craft->getPilotDodgeBonus(pilots, mod);
+	setup.pilotApproachSpeedModifier = craft->getPilotApproachSpeedModifier(pilots, mod);
+	setup.craftAccelerationBonus = 2; // vanilla
+	if (!pilots.empty())
+	{
+		setup.craftAccelerationBonus = std::min(4, (setup.craftStats.accel / 3) + 1);
+	}
+
+	setup.ufoRules = ufo->getRules();
+	setup.ufoStats = ufo->getCraftStats();
+	setup.ufoIsAttacking = ufoIsAttacking;
+	setup.ufoHuntBehavior = ufo->getHuntBehavior();
+	setup.ufoNeverCrashLands = setup.ufoHuntBehavior == 1 || ufo->getRules()->isUnmanned();
+	readUfo(setup, ufo);
+
+	setup.difficulty = difficulty;
+	setup.mode = DSM_STANDOFF;
+	if (ufoIsAttacking)
+	{
+		setup.cannotDisengage = setup.ufoStats.speedMax >= setup.craftStats.speedMax;
+		setup.mode = DSM_AGGRESSIVE;
+		// make sure the HK attacks its primary target first!
+		Craft *target = dynamic_cast<Craft*>(ufo->getDestination());
+		if (target)
+		{
+			if (craft != target)
+			{
+				// push secondary targets a tiny bit away from the HK
+				setup.startDistance += 16;
+			}
+			else
+			{
+				// approach primary target at maximum approach speed
+				setup.pilotApproachSpeedModifier = 4;
+			}
+		}
+	}
+	if (setup.missileCraft)
+	{
+		// approach UFO at maximum approach speed
+		setup.cannotDisengage = true;
+		setup.pilotApproachSpeedModifier = 4;
+		setup.mode = DSM_AGGRESSIVE;
+	}
+	return setup;
+}
+
+/**
+ * Prepares an interception the same way DogfightState's constructor
+ * does, with the attack mode picked before the first tick.
+ * @param mod Pointer to the mod.
+ * @param setup Setup of the interception.
+ * @param random Random state to draw from.
+ * @param listener Listener to report the events to, if any.
+ */
+DogfightSimulator::DogfightSimulator(Mod *mod, const DogfightSetup &setup, RNG::RandomState &random, DogfightListener *listener) :
+	_mod(mod), _setup(setup), _random(random), _listener(listener),
+	_currentDist(setup.startDistance), _targetDist(STANDOFF_DIST), _timeout(50), _ufoSize(0),
+	_minimized(false), _selfDestruct(false), _craftDefenseless(false),
+	_ufoBreakingOff(false), _missileImpact(false), _end(false), _endUfoHandled(false), _endCraftHandled(false), _ufoShotDown(false), _ufoLanded(false), _ufoLost(false)
+{
+	size_t weaponNum = _setup.weapons.size();
+	_fireInterval.resize(weaponNum, 0);
+	_fireCountdown.resize(weaponNum, 0);
+	_tractorLockedOn.resize(weaponNum, false);
+
+	// don't set these variables if the ufo is already engaged in a dogfight
+	if (!_setup.ufoEscapeCountdown)
+	{
+		int diff = _setup.difficulty;
+		int breakOffTime = _setup.ufoRules->getBreakOffTime();
+		_setup.ufoFireCountdown = 0;
+		int escapeCountdown = breakOffTime + _random.generate(0, breakOffTime) - 30 * Mod::DIFFICULTY_COEFFICIENT[std::min(diff, 4)];
+		auto& custom = _mod->getUfoEscapeCountdownCoefficients();
+		if (custom.size() > (size_t)diff)
+		{
+			escapeCountdown = breakOffTime + _random.generate(0, breakOffTime);
+			escapeCountdown = escapeCountdown * custom[diff] / 100;
+		}
+		_setup.ufoEscapeCountdown = std::max(1, escapeCountdown);
+	}
+
+	_ufoSize = std::min(_setup.ufoRules->getBlobSize(), 4); // yes, maximum supported is 4, not a typo
+
+	for (size_t i = 0; i < weaponNum; ++i)
+	{
+		const RuleCraftWeapon *w = _setup.weapons[i].rules;
+		if (w)
+		{
+			_fireInterval[i] = _setup.ufoIsAttacking ? w->getAggressiveReload() : w->getStandardReload();
+		}
+	}
+	setMode(_setup.mode);
+}
+
+/**
+ * Copies the values that may have changed outside this interception:
+ * other interceptions of the same UFO, the geoscape freeing the UFO's
+ * timers, or the window itself.
+ * @param craft Pointer to the craft.
+ * @param ufo Pointer to the UFO.
+ */
+void DogfightSimulator::loadFromGame(Craft *craft, const Ufo *ufo)
+{
+	_setup.craftDamage = craft->getDamage();
+	_setup.craftShield = craft->getShield();
+	for (size_t i = 0; i < _setup.weapons.size(); ++i)
+	{
+		CraftWeapon *w = craft->getWeapons()->at(i);
+		if (w)
+		{
+			_setup.weapons[i].ammo = w->getAmmo();
+		}
+	}
+	readUfo(_setup, ufo);
+}
+
+/**
+ * Copies the values changed by the last tick back to the game.
+ * The UFO's damage isn't copied: the listener applies every hit
+ * as it happens, since the game reacts to it right away.
+ * @param craft Pointer to the craft.
+ * @param ufo Pointer to the UFO.
+ */
+void DogfightSimulator::saveToGame(Craft *craft, Ufo *ufo) const
+{
+	craft->setDamage(_setup.craftDamage);
+	craft->setShield(_setup.craftShield);
+	for (size_t i = 0; i < _setup.weapons.size(); ++i)
+	{
+		CraftWeapon *w = craft->getWeapons()->at(i);
+		if (w)
+		{
+			w->setAmmo(_setup.weapons[i].ammo);
+		}
+	}
+	ufo->setShield(_setup.ufoShield);
+	if (ufo->getSpeed() != _setup.ufoSpeed)
+	{
+		ufo->setSpeed(_setup.ufoSpeed);
+	}
+	ufo->setEscapeCountdown(_setup.ufoEscapeCountdown);
+	ufo->setFireCountdown(_setup.ufoFireCountdown);
+	ufo->setTractorBeamSlowdown(_setup.ufoTractorBeamSlowdown);
+	ufo->setInterceptionProcessed(_setup.ufoInterceptionProcessed);
+	ufo->setShootingAt(_setup.ufoShootingAt);
+	ufo->setShieldRechargeHandle(_setup.ufoShieldRechargeHandle);
+}
+
+/**
+ * Changes the attack mode the way the mode buttons do:
+ * reloads per mode and the distance to keep. Disengaging
+ * ends the dogfight once the craft is out of range.
+ * @param mode New attack mode.
+ */
+void DogfightSimulator::setMode(DogfightSimulationMode mode)
+{
+	_setup.mode = mode;
+	_end = (mode == DSM_DISENGAGE);
+	for (size_t i = 0; i < _setup.weapons.size(); ++i)
+	{
+		const RuleCraftWeapon *w = _setup.weapons[i].rules;
+		if (!w)
+		{
+			continue;
+		}
+		switch (mode)
+		{
+		case DSM_CAUTIOUS:
+			// evasive maneuvers against a HK double the craft's reload time to balance halving the HK's chance to hit
+			_fireInterval[i] = _setup.ufoIsAttacking ? w->getAggressiveReload() * 2 : w->getCautiousReload();
+			break;
+		case DSM_STANDARD:
+			_fireInterval[i] = w->getStandardReload();
+			break;
+		case DSM_AGGRESSIVE:
+			_fireInterval[i] = w->getAggressiveReload();
+			break;
+		default:
+			break;
+		}
+	}
+	switch (mode)
+	{
+	case DSM_STANDOFF:
+		_targetDist = STANDOFF_DIST;
+		break;
+	case DSM_CAUTIOUS:
+		if (_setup.ufoIsAttacking)
+			aggressiveDistance(); // same distance as aggressive (by design)
+		else
+			minimumDistance();
+		break;
+	case DSM_STANDARD:
+		maximumDistance();
+		break;
+	case DSM_AGGRESSIVE:
+		aggressiveDistance();
+		break;
+	case DSM_DISENGAGE:
+		_targetDist = 800;
+		break;
+	}
+	setStatus();
+}
+
+/**
+ * Checks if the UFO is crashed, mirroring Ufo::isCrashed().
+ * @return True if crashed or destroyed.
+ */
+bool DogfightSimulator::ufoCrashed() const
+{
+	if (ufoDestroyed())
+		return true;
+	if (_setup.ufoNeverCrashLands)
+		return false;
+	return _setup.ufoDamage > _setup.ufoStats.damageMax / 2;
+}
+
+/**
+ * Reports an event to the listener, if any.
+ * @param event What happened.
+ * @param value Weapon slot or damage, depending on the event.
+ * @param extra Shield damage, depending on the event.
+ */
+void DogfightSimulator::notify(DogfightEvent event, int value, int extra)
+{
+	if (_listener)
+	{
+		_listener->dogfightEvent(event, value, extra);
+	}
+}
+
+/**
+ * Resolves the UFO going down. The listener decides in the game;
+ * otherwise the setup tells if it's over water, drawing the same
+ * random numbers as the game does for a UFO this craft shot down.
+ * @param forcedDown Was it brought down by tractor beams?
+ * @return True if the UFO was lost on the way down.
+ */
+bool DogfightSimulator::ufoDown(bool forcedDown)
+{
+	if (_listener)
+	{
+		return _listener->dogfightUfoDown(forcedDown);
+	}
+
+	bool survived = true;
+	if (forcedDown)
+	{
+		if (_setup.overWater)
+		{
+			survived = false; // destroyed on real water
+		}
+		else if (_setup.overFakeWater && !_random.percent(_setup.ufoRules->getSplashdownSurvivalChance()))
+		{
+			survived = false; // destroyed on fake water
+		}
+		if (_setup.ufoRules->isUnmanned())
+		{
+			survived = false; // unmanned UFOs (drones, missiles, etc.) can't be forced to land
+		}
+		if (survived)
+		{
+			_random.generate(30, 120); // landing site lifetime
+		}
+		return !survived;
+	}
+
+	// Check for retaliation trigger.
+	if (_random.percent(_setup.retaliationOdds))
+	{
+		int diff = _setup.difficulty;
+		int regionOdds = 50 - 6 * Mod::DIFFICULTY_COEFFICIENT[std::min(diff, 4)];
+		auto& custom = _mod->getRetaliationBaseRegionOdds();
+		if (custom.size() > (size_t)diff)
+		{
+			regionOdds = 100 - custom[diff];
+		}
+		_random.percent(regionOdds);
+	}
+	setStatus();
+	if (!ufoDestroyed())
+	{
+		if (_setup.overWater)
+		{
+			survived = false; // destroyed on real water
+		}
+		else if (_setup.overFakeWater)
+		{
+			survived = _random.percent(_setup.ufoRules->getSplashdownSurvivalChance());
+			setStatus();
+		}
+		if (survived)
+		{
+			_random.generate(24, 96); // crash site lifetime
+		}
+	}
+	return !survived;
+}
+
+/**
+ * Sets the craft to the minimum distance
+ * required to fire a weapon.
+ */
+void DogfightSimulator::minimumDistance()
+{
+	int max = 0;
+	for (const auto &w : _setup.weapons)
+	{
+		if (w.rules && w.rules->getRange() > max && w.ammo > 0)
+		{
+			max = w.rules->getRange();
+		}
+	}
+	_targetDist = max == 0 ? STANDOFF_DIST : max * 8;
+}
+
+/**
+ * Sets the craft to the maximum distance
+ * required to fire a weapon.
+ */
+void DogfightSimulator::maximumDistance()
+{
+	int min = 1000;
+	for (const auto &w : _setup.weapons)
+	{
+		if (w.rules && w.rules->getRange() < min && w.ammo > 0)
+		{
+			min = w.rules->getRange();
+		}
+	}
+	if (_setup.ufoIsAttacking)
+	{
+		// If the UFO is actively hunting us, consider its weapon range too
+		int ufoRange = _setup.ufoRules->getWeaponRange();
+		if (ufoRange > 0 && ufoRange < min)
+		{
+			min = ufoRange;
+		}
+	}
+	_targetDist = min == 1000 ? STANDOFF_DIST : min * 8;
+}
+
+/**
+ * Sets the craft to the maximum distance or 8 km, whichever is smaller.
+ */
+void DogfightSimulator::aggressiveDistance()
+{
+	maximumDistance();
+	_targetDist = std::min(_targetDist, AGGRESSIVE_DIST);
+}
+
+/**
+ * Each time a UFO will try to fire it's cannons
+ * a calculation is made. There's only 10% chance
+ * that it will actually fire.
+ */
+void DogfightSimulator::ufoFireWeapon()
+{
+	int diff = _setup.difficulty;
+	int reload = _setup.ufoRules->getWeaponReload();
+	int fireCountdown = std::max(1, reload - 2 * Mod::DIFFICULTY_COEFFICIENT[std::min(diff, 4)]);
+	auto& custom = _mod->getUfoFiringRateCoefficients();
+	if (custom.size() > (size_t)diff)
+	{
+		fireCountdown = std::max(1, reload * custom[diff] / 100);
+	}
+	_setup.ufoFireCountdown = _random.generate(0, fireCountdown) + fireCountdown;
+	setStatus();
+
+	CraftWeaponProjectile p;
+	p.setType(CWPT_PLASMA_BEAM);
+	p.setAccuracy(60);
+	p.setDamage(_setup.ufoRules->getWeaponPower());
+	p.setDirection(D_DOWN);
+	p.setHorizontalPosition(HP_CENTER);
+	p.setPosition(_currentDist - (_setup.ufoRules->getRadius() / 2));
+	_projectiles.push_back(p);
+	if (_setup.ufoIsAttacking && _setup.cannotDisengage)
+	{
+		_setup.ufoSoftlockShotCounter++;
+	}
+	_result.ufoShotsFired++;
+	notify(DFE_UFO_FIRED);
+}
+
+/**
+ * Runs one tick of the dogfight: UFO timers, break off, distance,
+ * shields, projectiles and hits, weapons fire and the end of the fight.
+ * While minimized, only the break off and the end of the fight are handled.
+ * @return True when the dogfight is over.
+ */
+bool DogfightSimulator::tick()
+{
+	const RuleCraftStats &craftStats = _setup.craftStats;
+	const RuleCraftStats &ufoStats = _setup.ufoStats;
+	bool finalRun = false;
+
+	if (!_minimized)
+	{
+		// Clears text after a while
+		if (_timeout > 0)
+		{
+			--_timeout;
+		}
+
+		if (!ufoCrashed() && !craftDestroyed() && !_setup.ufoInterceptionProcessed)
+		{
+			_setup.ufoInterceptionProcessed = true;
+			int escapeCounter = _setup.ufoEscapeCountdown;
+			if (_setup.ufoIsAttacking)
+			{
+				if (_setup.cannotDisengage && _setup.ufoSoftlockShotCounter >= _setup.ufoRules->getSoftlockThreshold())
+				{
+					escapeCounter = 1; // game is in softlock, stop being a hunter-killer and disengage!
+				}
+				else if (_setup.ufoDamage > ufoStats.damageMax / 3 && _setup.ufoHuntBehavior != 1)
+				{
+					// TODO: rethink: unhardcode run away thresholds?
+					if (_setup.craftDamage > craftStats.damageMax / 2)
+					{
+						escapeCounter = 999; // it's gonna be tight, continue shooting...
+					}
+					else
+					{
+						escapeCounter = 1; // we're badly hurt and xcom isn't, abort immediately!
+					}
+				}
+				else
+				{
+					escapeCounter = 999; // we're still ok, continue shooting...
+				}
+			}
+
+			if (escapeCounter > 0)
+			{
+				escapeCounter--;
+				_setup.ufoEscapeCountdown = escapeCounter;
+				// Check if UFO is breaking off.
+				if (escapeCounter == 0)
+				{
+					_setup.ufoSpeed = ufoStats.speedMax;
+					if (_setup.ufoIsAttacking)
+					{
+						// stop being a hunter-killer and run away!
+						_setup.ufoHunterKiller = false;
+					}
+					notify(DFE_UFO_ESCAPING);
+				}
+			}
+			if (_setup.ufoFireCountdown > 0)
+			{
+				_setup.ufoFireCountdown--;
+			}
+		}
+	}
+
+	// Crappy craft is chasing UFO.
+	int speedMinusTractors = std::max(0, _setup.ufoSpeed - _setup.ufoTractorBeamSlowdown);
+	if (speedMinusTractors > craftStats.speedMax)
+	{
+		if (!_setup.ufoIsAttacking || !_setup.ufoHunterKiller)
+		{
+			_ufoBreakingOff = true;
+			finalRun = true;
+			setStatus();
+			notify(DFE_UFO_OUTRUNNING);
+		}
+	}
+	else
+	{
+		_ufoBreakingOff = false;
+	}
+
+	bool projectileInFlight = false;
+	if (!_minimized)
+	{
+		int distanceChange = 0;
+
+		// Update distance
+		if (!_ufoBreakingOff)
+		{
+			if (_currentDist < _targetDist && !ufoCrashed() && !craftDestroyed())
+			{
+				distanceChange = std::min(2 * _setup.craftAccelerationBonus, _targetDist - _currentDist); // disengage speed
+			}
+			else if (_currentDist > _targetDist && !ufoCrashed() && !craftDestroyed())
+			{
+				distanceChange = -1 * _setup.pilotApproachSpeedModifier; // engage speed
+			}
+
+			// don't let the interceptor mystically push or pull its fired projectiles
+			for (auto &p : _projectiles)
+			{
+				if (p.getGlobalType() != CWPGT_BEAM && p.getDirection() == D_UP)
+				{
+					p.setPosition(p.getPosition() + distanceChange);
+				}
+			}
+		}
+		else
+		{
+			distanceChange = 4; // ufo breaking off speed
+		}
+		_currentDist += distanceChange;
+
+		// UFO shields, recharged by one of the interceptions only
+		if (_setup.ufoShieldRechargeHandle == 0)
+		{
+			_setup.ufoShieldRechargeHandle = _setup.interceptionNumber;
+		}
+		if (_setup.ufoShield != 0 && _setup.interceptionNumber == _setup.ufoShieldRechargeHandle)
+		{
+			int total = ufoStats.shieldRecharge / 100;
+			if (_random.percent(ufoStats.shieldRecharge % 100))
+				total++;
+			_setup.ufoShield = std::max(0, std::min(ufoStats.shieldCapacity, _setup.ufoShield + total));
+		}
+
+		// Player craft shields
+		if (_setup.craftShield != 0)
+		{
+			int total = craftStats.shieldRecharge / 100;
+			if (_random.percent(craftStats.shieldRecharge % 100))
+				total++;
+			if (total != 0)
+			{
+				_setup.craftShield = std::max(0, std::min(craftStats.shieldCapacity, _setup.craftShield + total));
+				notify(DFE_CRAFT_SHIELD_RECHARGED);
+			}
+		}
+
+		auto damageUfo = [&](int damage, int shieldDamage)
+		{
+			_setup.ufoDamage = std::max(0, _setup.ufoDamage + damage);
+			_result.ufoDamageDealt += damage;
+			if (ufoCrashed())
+			{
+				_ufoShotDown = true;
+				_setup.ufoSpeed = 0;
+				// if the ufo got destroyed here, these no longer apply
+				_ufoBreakingOff = false;
+				finalRun = false;
+				_end = false;
+			}
+			setStatus();
+			notify(DFE_UFO_HIT, damage, shieldDamage);
+		};
+
+		// Is the craft itself a projectile?
+		if (_setup.missileCraft && !_missileImpact && !craftDestroyed() && _currentDist <= AGGRESSIVE_DIST) // Note: hard-coded distance, ok
+		{
+			_missileImpact = true;
+
+			// Missile self-destruct
+			_setup.craftDamage = craftStats.damageMax;
+			notify(DFE_MISSILE_IMPACT);
+
+			int damage = _setup.missilePower; // Note: no randomness :(
+			int shieldDamage = 0;
+			if (_setup.ufoShield != 0)
+			{
+				shieldDamage = damage; // Note: no shield-effectiveness factor
+				// scale down by bleed-through factor
+				damage = std::max(0, shieldDamage - _setup.ufoShield) * ufoStats.shieldBleedThrough;
+				_setup.ufoShield = std::max(0, std::min(ufoStats.shieldCapacity, _setup.ufoShield - shieldDamage));
+			}
+			damageUfo(std::max(0, damage - ufoStats.armor), shieldDamage);
+		}
+
+		// Move projectiles and check for hits.
+		for (auto &p : _projectiles)
+		{
+			p.move();
+			// Projectiles fired by interceptor.
+			if (p.getDirection() == D_UP)
+			{
+				// Projectile reached the UFO - determine if it's been hit.
+				if ((p.getPosition() >= _currentDist || (p.getGlobalType() == CWPGT_BEAM && p.toBeRemoved())) && !ufoCrashed() && !p.getMissed())
+				{
+					int chanceToHit = (p.getAccuracy() * (100 + 300 / (5 - _ufoSize)) + 100) / 200; // vanilla xcom
+					chanceToHit -= ufoStats.avoidBonus;
+					chanceToHit += craftStats.hitBonus;
+					chanceToHit += _setup.pilotAccuracyBonus;
+					if (_random.percent(chanceToHit))
+					{
+						// Formula delivered by Volutar, altered by Extended version.
+						int power = p.getDamage() * (craftStats.powerBonus + 100) / 100;
+
+						// Handle UFO shields
+						int damage = _random.generate(power / 2, power);
+						int shieldDamage = 0;
+						if (_setup.ufoShield != 0)
+						{
+							shieldDamage = damage * p.getShieldDamageModifier() / 100;
+							if (p.getShieldDamageModifier() == 0)
+							{
+								damage = 0;
+							}
+							else
+							{
+								// scale down by bleed-through factor and scale up by shield-effectiveness factor
+								damage = std::max(0, shieldDamage - _setup.ufoShield) * ufoStats.shieldBleedThrough / p.getShieldDamageModifier();
+							}
+							_setup.ufoShield = std::max(0, std::min(ufoStats.shieldCapacity, _setup.ufoShield - shieldDamage));
+						}
+						_result.shotsHit++;
+						damageUfo(std::max(0, damage - ufoStats.armor), shieldDamage);
+						p.remove();
+					}
+					// Missed.
+					else if (p.getGlobalType() == CWPGT_BEAM)
+					{
+						p.remove();
+					}
+					else
+					{
+						p.setMissed(true);
+					}
+				}
+				// Check if projectile passed it's maximum range.
+				if (p.getGlobalType() == CWPGT_MISSILE && p.getPosition() / 8 >= p.getRange())
+				{
+					p.remove();
+				}
+				else if (!ufoCrashed())
+				{
+					projectileInFlight = true;
+				}
+			}
+			// Projectiles fired by UFO.
+			else if (p.getDirection() == D_DOWN)
+			{
+				if (p.getGlobalType() == CWPGT_MISSILE || (p.getGlobalType() == CWPGT_BEAM && p.toBeRemoved()))
+				{
+					int chanceToHit = p.getAccuracy(); // vanilla xcom
+					chanceToHit -= craftStats.avoidBonus;
+					chanceToHit += ufoStats.hitBonus;
+					chanceToHit -= _setup.pilotDodgeBonus;
+					// evasive maneuvers
+					if (_setup.ufoIsAttacking && _setup.mode == DSM_CAUTIOUS)
+					{
+						// HK's chance to hit is halved, but craft's reload time is doubled too
+						chanceToHit = chanceToHit / 2;
+					}
+					if (_random.percent(chanceToHit) || _selfDestruct)
+					{
+						// Formula delivered by Volutar, altered by Extended version.
+						int power = p.getDamage() * (ufoStats.powerBonus + 100) / 100;
+						int damage = _random.generate(0, power);
+						_result.ufoShotsHit++;
+
+						if (_setup.craftShield != 0)
+						{
+							int shieldBleedThroughDamage = std::max(0, damage - _setup.craftShield) * craftStats.shieldBleedThrough / 100;
+							_setup.craftShield = std::max(0, std::min(craftStats.shieldCapacity, _setup.craftShield - damage));
+							damage = shieldBleedThroughDamage;
+							setStatus();
+							notify(DFE_CRAFT_SHIELD_HIT);
+						}
+
+						damage = std::max(0, damage - craftStats.armor);
+
+						// if a totally crappy HK is attacking a completely defenseless craft, avoid endless fight
+						if (_selfDestruct)
+						{
+							damage = craftStats.damageMax;
+						}
+
+						if (damage)
+						{
+							_setup.craftDamage += damage;
+							_result.craftDamageTaken += damage;
+							setStatus();
+							notify(DFE_CRAFT_HIT, damage);
+							if (_setup.mode == DSM_CAUTIOUS && (int)floor((double)_setup.craftDamage / craftStats.damageMax * 100) >= 50 && !_setup.ufoIsAttacking)
+							{
+								_targetDist = STANDOFF_DIST;
+							}
+						}
+					}
+					p.remove();
+				}
+			}
+		}
+
+		// Remove projectiles that hit or missed their target.
+		_projectiles.erase(std::remove_if(_projectiles.begin(), _projectiles.end(),
+			[](const CraftWeaponProjectile &p)
+			{
+				return p.toBeRemoved() || (p.getMissed() && p.getPosition() <= 0);
+			}), _projectiles.end());
+
+		// Check if the situation is hopeless for the craft
+		if (_setup.cannotDisengage && !_craftDefenseless && !_setup.missileCraft && _projectiles.empty())
+		{
+			bool hasNoAmmo = true;
+			for (const auto &w : _setup.weapons)
+			{
+				if (w.rules && w.ammo > 0)
+				{
+					hasNoAmmo = false;
+					break;
+				}
+			}
+			// no projectiles in the air and no ammo left
+			if (hasNoAmmo)
+			{
+				_craftDefenseless = true;
+				notify(DFE_CRAFT_DEFENSELESS);
+			}
+		}
+
+		// Handle weapons and craft distance.
+		bool attacking = _setup.mode != DSM_STANDOFF && _setup.mode != DSM_DISENGAGE;
+		for (size_t i = 0; i < _setup.weapons.size(); ++i)
+		{
+			DogfightSetup::Weapon &w = _setup.weapons[i];
+			if (!w.rules || _setup.missileCraft)
+			{
+				continue;
+			}
+			bool inRange = _currentDist <= w.rules->getRange() * 8 && attacking && !ufoCrashed() && !craftDestroyed();
+
+			// Handle weapon firing
+			if (_fireCountdown[i] == 0 && inRange && w.ammo > 0)
+			{
+				if (w.enabled)
+				{
+					w.ammo--;
+					_fireCountdown[i] = _fireInterval[i];
+
+					CraftWeaponProjectile p;
+					p.setType(w.rules->getProjectileType());
+					p.setSpeed(w.rules->getProjectileSpeed());
+					p.setAccuracy(w.rules->getAccuracy());
+					p.setDamage(w.rules->getDamage());
+					p.setRange(w.rules->getRange());
+					p.setShieldDamageModifier(w.rules->getShieldDamageModifier());
+					p.setDirection(D_UP);
+					p.setHorizontalPosition((i % 2 ? HP_RIGHT : HP_LEFT) * (1 + 2 * ((int)i / 2)));
+					_projectiles.push_back(p);
+
+					_result.shotsFired++;
+					_result.ammoUsed++;
+					notify(DFE_WEAPON_FIRED, (int)i);
+					projectileInFlight = true;
+				}
+			}
+			else if (_fireCountdown[i] > 0)
+			{
+				--_fireCountdown[i];
+			}
+
+			// Handle craft tractor beams, the UFO keeps the slowdown within 0 and its top speed
+			if (w.rules->getTractorBeamPower() != 0)
+			{
+				int slowdown = w.rules->getTractorBeamPower() * _mod->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
+				if (inRange && w.enabled)
+				{
+					if (!_tractorLockedOn[i])
+					{
+						_tractorLockedOn[i] = true;
+						_setup.ufoTractorBeamSlowdown = std::max(0, std::min(ufoStats.speedMax, _setup.ufoTractorBeamSlowdown + slowdown));
+						setStatus();
+						notify(DFE_TRACTOR_BEAM_ENGAGED, (int)i);
+					}
+				}
+				else if (_tractorLockedOn[i])
+				{
+					_tractorLockedOn[i] = false;
+					_setup.ufoTractorBeamSlowdown = std::max(0, std::min(ufoStats.speedMax, _setup.ufoTractorBeamSlowdown - slowdown));
+					setStatus();
+					notify(DFE_TRACTOR_BEAM_DISENGAGED, (int)i);
+				}
+			}
+
+			if (w.ammo == 0 && !projectileInFlight && !craftDestroyed())
+			{
+				// Handle craft distance according to option set by user and available ammo.
+				if (_setup.mode == DSM_CAUTIOUS && !_setup.ufoIsAttacking)
+				{
+					minimumDistance();
+				}
+				else if (_setup.mode == DSM_STANDARD)
+				{
+					maximumDistance();
+				}
+			}
+		}
+
+		// Handle UFO firing, the UFO shoots at one of the interceptions only
+		if (_currentDist <= _setup.ufoRules->getWeaponRange() * 8 && !ufoCrashed() && !craftDestroyed())
+		{
+			if (_setup.ufoShootingAt == 0)
+			{
+				_setup.ufoShootingAt = _setup.interceptionNumber;
+			}
+			if (_setup.ufoShootingAt == _setup.interceptionNumber && _setup.ufoFireCountdown == 0)
+			{
+				ufoFireWeapon();
+			}
+		}
+		else if (_setup.ufoShootingAt == _setup.interceptionNumber)
+		{
+			_setup.ufoShootingAt = 0;
+		}
+	}
+
+	// Check when battle is over.
+	if (_end && (((_currentDist > 640 || _minimized) && (_setup.mode == DSM_DISENGAGE || _ufoBreakingOff)) || (_timeout == 0 && (ufoCrashed() || craftDestroyed()))))
+	{
+		return true;
+	}
+
+	if (_currentDist > 640 && _ufoBreakingOff)
+	{
+		finalRun = true;
+	}
+
+	if (!_end)
+	{
+		if (_endCraftHandled)
+		{
+			finalRun = true;
+		}
+		else if (craftDestroyed())
+		{
+			// a missile that hit doesn't say it self-destructed
+			if (!_setup.missileCraft || !_missileImpact)
+			{
+				setStatus();
+			}
+			notify(DFE_CRAFT_DESTROYED, _missileImpact);
+			_timeout += 30;
+			finalRun = true;
+			_endCraftHandled = true;
+			_setup.ufoShootingAt = 0;
+		}
+
+		if (_endUfoHandled)
+		{
+			finalRun = true;
+		}
+		else if (ufoCrashed())
+		{
+			// End dogfight if UFO is crashed or destroyed.
+			_endUfoHandled = true;
+			if (ufoDown(false))
+			{
+				_ufoLost = true;
+			}
+			_timeout += 30;
+			if (!_ufoShotDown)
+			{
+				_timeout += 50; // someone else shot it down
+			}
+			finalRun = true;
+		}
+		else if (ufoStats.speedMax - _setup.ufoTractorBeamSlowdown == 0) // UFO brought down by tractor beam
+		{
+			_endUfoHandled = true;
+			finalRun = true;
+			bool lost = ufoDown(true);
+			_setup.ufoSpeed = 0;
+			if (lost)
+			{
+				_setup.ufoDamage = ufoStats.damageMax;
+				_ufoLost = true;
+			}
+			else
+			{
+				_setup.ufoTractorBeamSlowdown = 0;
+				_setup.ufoShootingAt = 0;
+				_ufoLanded = true;
+			}
+		}
+	}
+
+	if (!projectileInFlight && finalRun)
+	{
+		_end = true;
+	}
+	return false;
+}
+
+/**
+ * Runs ticks until the interception is over, freeing
+ * the UFO's timers each tick like the geoscape does.
+ * @param maxTicks Give up after this many ticks.
+ * @return Summary of the interception.
+ */
+DogfightResult DogfightSimulator::run(int maxTicks)
+{
+	_result = DogfightResult();
+
+	// DogfightState picks its start sound on the first think(), before the first update()
+	auto& sounds = _mod->getStartDogfightSounds();
+	if (!sounds.empty())
+	{
+		_random.generate(0, sounds.size() - 1);
+	}
+
+	bool done = false;
+	while (!done && _result.ticks < maxTicks)
+	{
+		_setup.ufoInterceptionProcessed = false;
+		// DogfightState::think() ends the dogfight as soon as the UFO has landed
+		done = tick() || _ufoLanded;
+		_result.ticks++;
+	}
+
+	_result.craftDestroyed = craftDestroyed();
+	if (!done)
+		_result.outcome = DFO_TIMEOUT;
+	else if (ufoDestroyed() || _ufoLost)
+		_result.outcome = DFO_UFO_DESTROYED;
+	else if (_ufoLanded)
+		_result.outcome = DFO_UFO_FORCED_DOWN;
+	else if (ufoCrashed())
+		_result.outcome = DFO_UFO_CRASHED;
+	else if (_result.craftDestroyed)
+		_result.outcome = DFO_CRAFT_DESTROYED;
+	else if (_ufoBreakingOff)
+		_result.outcome = DFO_UFO_ESCAPED;
+	return _result;
+}
+
+}
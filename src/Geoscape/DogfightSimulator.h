@@ -0,0 +1,227 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "../Mod/RuleCraft.h"
+#include "../Engine/RNG.h"
+#include "../Savegame/CraftWeaponProjectile.h"
+
+namespace OpenXcom
+{
+
+const int STANDOFF_DIST = 560;
+const int AGGRESSIVE_DIST = 64;
+
+class Mod;
+class RuleUfo;
+class RuleCraftWeapon;
+class Craft;
+class Ufo;
+
+/// Attack modes an interceptor can fly.
+enum DogfightSimulationMode { DSM_STANDOFF, DSM_CAUTIOUS, DSM_STANDARD, DSM_AGGRESSIVE, DSM_DISENGAGE };
+
+/// Ways a simulated interception can end.
+enum DogfightOutcome { DFO_NONE, DFO_UFO_CRASHED, DFO_UFO_DESTROYED, DFO_UFO_FORCED_DOWN, DFO_UFO_ESCAPED, DFO_CRAFT_DESTROYED, DFO_TIMEOUT };
+
+/// Things that happen during a dogfight tick, reported to a DogfightListener.
+enum DogfightEvent
+{
+	DFE_UFO_ESCAPING,           ///< The escape countdown ran out, the UFO speeds up.
+	DFE_UFO_OUTRUNNING,         ///< The UFO is faster than the craft.
+	DFE_CRAFT_SHIELD_RECHARGED,
+	DFE_MISSILE_IMPACT,         ///< A missile craft blew itself up at the UFO.
+	DFE_UFO_HIT,                ///< value: damage taken, extra: damage to the shield.
+	DFE_CRAFT_SHIELD_HIT,
+	DFE_CRAFT_HIT,
+	DFE_CRAFT_DEFENSELESS,      ///< No way to disengage, no ammo and nothing in flight.
+	DFE_WEAPON_FIRED,           ///< value: weapon slot.
+	DFE_TRACTOR_BEAM_ENGAGED,   ///< value: weapon slot.
+	DFE_TRACTOR_BEAM_DISENGAGED,///< value: weapon slot.
+	DFE_UFO_FIRED,
+	DFE_CRAFT_DESTROYED,        ///< value: a missile craft hit the UFO first.
+};
+
+/**
+ * Everything an interception depends on: the craft, the UFO, and
+ * the values the UFO shares with other interceptions. The simulator
+ * keeps its copy up to date as the fight goes on.
+ */
+struct DogfightSetup
+{
+	struct Weapon
+	{
+		const RuleCraftWeapon *rules = nullptr;
+		int ammo = 0;
+		bool enabled = true;
+	};
+
+	RuleCraftStats craftStats;
+	int craftDamage = 0, craftShield = 0;
+	bool missileCraft = false;
+	int missilePower = 0;
+	std::vector<Weapon> weapons;
+	int pilotAccuracyBonus = 0, pilotDodgeBonus = 0;
+	int pilotApproachSpeedModifier = 2, craftAccelerationBonus = 2;
+	bool cannotDisengage = false;
+
+	const RuleUfo *ufoRules = nullptr;
+	RuleCraftStats ufoStats;
+	int ufoDamage = 0, ufoShield = 0, ufoSpeed = 0;
+	int ufoEscapeCountdown = 0, ufoFireCountdown = 0, ufoTractorBeamSlowdown = 0;
+	bool ufoNeverCrashLands = false;
+	bool ufoIsAttacking = false, ufoHunterKiller = false;
+	int ufoHuntBehavior = 0, ufoSoftlockShotCounter = 0;
+	bool ufoInterceptionProcessed = false;
+	int ufoShootingAt = 0, ufoShieldRechargeHandle = 0;
+	int interceptionNumber = 1;
+	bool overWater = false, overFakeWater = false;
+
+	int startDistance = 640;
+	int difficulty = 0;
+	int retaliationOdds = 0;
+	DogfightSimulationMode mode = DSM_STANDARD;
+};
+
+/**
+ * Summary of a simulated interception.
+ */
+struct DogfightResult
+{
+	DogfightOutcome outcome = DFO_NONE;
+	int ticks = 0;
+	int craftDamageTaken = 0, ufoDamageDealt = 0;
+	int shotsFired = 0, shotsHit = 0;
+	int ufoShotsFired = 0, ufoShotsHit = 0;
+	int ammoUsed = 0;
+	bool craftDestroyed = false;
+};
+
+/**
+ * Gets told what happens in an interception while the tick runs,
+ * so it can show it and apply it to the game in the same order.
+ */
+class DogfightListener
+{
+public:
+	/// Cleans up the listener.
+	virtual ~DogfightListener() = default;
+	/// Handles an event of the current tick.
+	virtual void dogfightEvent(DogfightEvent event, int value, int extra) = 0;
+	/// Handles the UFO going down, returns true if it was lost on the way.
+	virtual bool dogfightUfoDown(bool forcedDown) = 0;
+};
+
+/**
+ * Runs the combat of an interception between one craft and one UFO:
+ * approach and break off, shields, projectile flight, hit and damage
+ * formulas, reloads per attack mode, tractor beams, UFO fire and the
+ * status timeout that keeps the window open after someone goes down.
+ * DogfightState drives one tick per update and renders from its state;
+ * run() resolves a whole interception without any user interface.
+ * Random numbers are drawn from the given state in the game's order,
+ * so the game passes its own generator and batch runs pass seeded ones.
+ * Without a listener, a UFO going down is resolved from the setup alone;
+ * the alien mission reacting to it and pilot experience are not simulated.
+ */
+class DogfightSimulator
+{
+public:
+	/// Upper bound on the simulated ticks.
+	static const int MAX_TICKS = 20000;
+
+	/// Builds a setup straight from rules, with full ammo, shields and no pilots.
+	static DogfightSetup setupFromRules(const RuleCraft *craft, const std::vector<const RuleCraftWeapon*> &weapons, const RuleUfo *ufo, int difficulty, DogfightSimulationMode mode);
+	/// Builds a setup from a craft intercepting a UFO in the game.
+	static DogfightSetup setupFromGame(const Mod *mod, Craft *craft, Ufo *ufo, bool ufoIsAttacking, int difficulty);
+
+	/// Prepares an interception.
+	DogfightSimulator(Mod *mod, const DogfightSetup &setup, RNG::RandomState &random, DogfightListener *listener = nullptr);
+	/// Copies the values shared with the game from the craft and the UFO.
+	void loadFromGame(Craft *craft, const Ufo *ufo);
+	/// Copies the values shared with the game back to the craft and the UFO.
+	void saveToGame(Craft *craft, Ufo *ufo) const;
+	/// Runs one tick, returns true when the dogfight is over.
+	bool tick();
+	/// Runs the interception to completion.
+	DogfightResult run(int maxTicks = MAX_TICKS);
+
+	/// Changes the attack mode.
+	void setMode(DogfightSimulationMode mode);
+	/// Pauses the combat while the window is minimized.
+	void setMinimized(bool minimized) { _minimized = minimized; }
+	/// Sets the number of the interception window.
+	void setInterceptionNumber(int number) { _setup.interceptionNumber = number; }
+	/// Toggles the self-destruct of a defenseless craft.
+	void setSelfDestruct(bool selfDestruct) { _selfDestruct = selfDestruct; }
+	/// Is the craft set to self-destruct?
+	bool getSelfDestruct() const { return _selfDestruct; }
+	/// Enables or disables a weapon.
+	void setWeaponEnabled(int slot, bool enabled) { _setup.weapons[slot].enabled = enabled; }
+	/// Is a weapon enabled?
+	bool isWeaponEnabled(int slot) const { return _setup.weapons[slot].enabled; }
+	/// Shows a status message, which keeps the window open a while longer.
+	void setStatus() { _timeout = 50; }
+
+	/// Gets the current values of the interception.
+	const DogfightSetup &getState() const { return _setup; }
+	/// Gets the distance between the craft and the UFO.
+	int getDistance() const { return _currentDist; }
+	/// Gets the projectiles in flight.
+	const std::vector<CraftWeaponProjectile> &getProjectiles() const { return _projectiles; }
+	/// Gets the ticks left before the status message is cleared.
+	int getStatusTimeout() const { return _timeout; }
+	/// Is the UFO breaking off?
+	bool isUfoBreakingOff() const { return _ufoBreakingOff; }
+	/// Is the craft out of options?
+	bool isCraftDefenseless() const { return _craftDefenseless; }
+private:
+	Mod *_mod;
+	DogfightSetup _setup;
+	RNG::RandomState &_random;
+	DogfightListener *_listener;
+	std::vector<CraftWeaponProjectile> _projectiles;
+	std::vector<int> _fireInterval, _fireCountdown;
+	std::vector<bool> _tractorLockedOn;
+	int _currentDist, _targetDist, _timeout, _ufoSize;
+	bool _minimized, _selfDestruct, _craftDefenseless;
+	bool _ufoBreakingOff, _missileImpact, _end, _endUfoHandled, _endCraftHandled, _ufoShotDown, _ufoLanded, _ufoLost;
+	DogfightResult _result;
+
+	/// Is the craft destroyed?
+	bool craftDestroyed() const { return _setup.craftDamage >= _setup.craftStats.damageMax; }
+	/// Is the UFO destroyed?
+	bool ufoDestroyed() const { return _setup.ufoDamage >= _setup.ufoStats.damageMax; }
+	/// Is the UFO crashed (or destroyed)?
+	bool ufoCrashed() const;
+	/// Reports an event to the listener.
+	void notify(DogfightEvent event, int value = 0, int extra = 0);
+	/// Resolves the UFO going down, returns true if it was lost.
+	bool ufoDown(bool forcedDown);
+	/// Sets the craft to the range of its longest ranged loaded weapon.
+	void minimumDistance();
+	/// Sets the craft to the range of its shortest ranged loaded weapon.
+	void maximumDistance();
+	/// Sets the craft to the aggressive attack range.
+	void aggressiveDistance();
+	/// Fires the UFO's weapon.
+	void ufoFireWeapon();
+};
+
+}
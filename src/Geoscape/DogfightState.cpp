@@ -29,7 +29,6 @@
 #include "../Interface/ImageButton.h"
 #include "../Interface/Text.h"
 #include "../Engine/Timer.h"
-#include "../Engine/Collections.h"
 #include "Globe.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/Soldier.h"
@@ -239,13 +238,11 @@ const int DogfightState::_projectileBlobs[4][6][3] =
  * @param ufoIsAttacking Is UFO the aggressor?
  */
 DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool ufoIsAttacking) :
-	_state(state), _craft(craft), _ufo(ufo),
-	_ufoIsAttacking(ufoIsAttacking), _missileCraft(craft->getRules()->isMissile()), _missileImpact(false),
+	_state(state), _craft(craft), _ufo(ufo), _sim(0),
+	_ufoIsAttacking(ufoIsAttacking), _missileCraft(craft->getRules()->isMissile()),
 	_disableDisengage(false), _disableStandoff(false), _disableCautious(false), _disableStandard(false), _disableAggressive(false),
-	_craftIsDefenseless(false), _selfDestructPressed(false),
-	_timeout(50), _currentDist(640), _targetDist(560),
-	_end(false), _endUfoHandled(false), _endCraftHandled(false), _ufoBreakingOff(false), _destroyUfo(false), _destroyCraft(false),
-	_minimized(false), _endDogfight(false), _animatingHit(false), _waitForPoly(false), _waitForAltitude(false), _ufoSize(0), _ufoBlobSize(0),
+	_destroyUfo(false), _destroyCraft(false),
+	_minimized(false), _endDogfight(false), _animatingHit(false), _waitForPoly(false), _waitForAltitude(false), _ufoBlobSize(0),
 	_craftHeight(0), _currentCraftDamageColor(0),
 	_interceptionNumber(0), _interceptionsCount(0), _x(0), _y(0), _minimizedIconX(0), _minimizedIconY(0), _firedAtLeastOnce(false), _experienceAwarded(false),
 	_delayedRecolorDone(false)
@@ -256,35 +253,17 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 	if (_weaponNum > RuleCraft::WeaponMax)
 		_weaponNum = RuleCraft::WeaponMax;
 
-	for (int i = 0; i < _weaponNum; ++i)
-	{
-		_weaponEnabled[i] = true;
-		_weaponFireCountdown[i] = 0;
-		_tractorLockedOn[i] = false;
-
-		CraftWeapon* w = _craft->getWeapons()->at(i);
-		if (w)
-		{
-			_weaponEnabled[i] = !w->isDisabled();
-		}
-	}
-
 	// pilot modifiers
-	const std::vector<Soldier*> pilots = _craft->getPilotList(false);
-
-	for (auto* pilot : pilots)
+	for (auto* pilot : _craft->getPilotList(false))
 	{
 		pilot->prepareStatsWithBonuses(_game->getMod()); // refresh soldier bonuses
 	}
-	_pilotAccuracyBonus = _craft->getPilotAccuracyBonus(pilots, _game->getMod());
-	_pilotDodgeBonus = _craft->getPilotDodgeBonus(pilots, _game->getMod());
-	_pilotApproachSpeedModifier = _craft->getPilotApproachSpeedModifier(pilots, _game->getMod());
 
-	_craftAccelerationBonus = 2; // vanilla
-	if (!pilots.empty())
-	{
-		_craftAccelerationBonus = std::min(4, (_craft->getCraftStats().accel / 3) + 1);
-	}
+	// the combat itself, drawing from the game's random numbers
+	DogfightSetup setup = DogfightSimulator::setupFromGame(_game->getMod(), _craft, _ufo, _ufoIsAttacking, _game->getSavedGame()->getDifficulty());
+	setup.interceptionNumber = _interceptionNumber;
+	_sim = new DogfightSimulator(_game->getMod(), setup, RNG::globalRandomState(), this);
+	_sim->saveToGame(_craft, _ufo);
 
 	// HK options
 	if (_ufoIsAttacking)
@@ -292,31 +271,11 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 		_disableStandoff = true;
 		_disableStandard = true;
 		_disableAggressive = false;
-		if (_ufo->getCraftStats().speedMax >= _craft->getCraftStats().speedMax)
-		{
-			_disableDisengage = true;
-		}
+		_disableDisengage = setup.cannotDisengage;
 		if (_weaponNum == 0)
 		{
 			_disableCautious = true;
 		}
-		// make sure the HK attacks its primary target first!
-		{
-			Craft* target = dynamic_cast<Craft*>(_ufo->getDestination());
-			if (target)
-			{
-				if (_craft != target)
-				{
-					// push secondary targets a tiny bit away from the HK
-					_currentDist += 16;
-				}
-				else
-				{
-					// approach primary target at maximum approach speed
-					_pilotApproachSpeedModifier = 4;
-				}
-			}
-		}
 	}
 	// Missile options
 	if (_missileCraft)
@@ -326,9 +285,6 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 		_disableAggressive = false;
 		_disableDisengage = true;
 		_disableCautious = true;
-
-		// approach UFO at maximum approach speed
-		_pilotApproachSpeedModifier = 4;
 	}
 
 	// Create objects
@@ -661,41 +617,7 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 
 	_craftDamageAnimTimer->onTimer((StateHandler)&DogfightState::animateCraftDamage);
 
-	// don't set these variables if the ufo is already engaged in a dogfight
-	if (!_ufo->getEscapeCountdown())
-	{
-		_ufo->setFireCountdown(0);
-		int escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime()) - 30 * _game->getSavedGame()->getDifficultyCoefficient();
-		{
-			int diff = _game->getSavedGame()->getDifficulty();
-			auto& custom = _game->getMod()->getUfoEscapeCountdownCoefficients();
-			if (custom.size() > (size_t)diff)
-			{
-				escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime());
-				escapeCountdown = escapeCountdown * custom[diff] / 100;
-			}
-		}
-		_ufo->setEscapeCountdown(std::max(1, escapeCountdown));
-	}
-
-	for (int i = 0; i < _weaponNum; ++i)
-	{
-		if (_craft->getWeapons()->at(i))
-		{
-			if (!_ufoIsAttacking)
-			{
-				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getStandardReload();
-			}
-			else
-			{
-				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getAggressiveReload();
-			}
-		}
-	}
-
-	// Set UFO size - going to be moved to Ufo class to implement simultaneous dogfights.
 	_ufoBlobSize = _ufo->getRules()->getBlobSize();
-	_ufoSize = std::min(_ufoBlobSize, 4); // yes, maximum supported is 4, not a typo
 
 	// Get crafts height. Used for damage indication.
 	for (int y = 0; y < _craftSprite->getHeight(); ++y)
@@ -727,11 +649,7 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 DogfightState::~DogfightState()
 {
 	delete _craftDamageAnimTimer;
-	while (!_projectiles.empty())
-	{
-		delete _projectiles.back();
-		_projectiles.pop_back();
-	}
+	delete _sim;
 }
 
 /**
@@ -753,9 +671,9 @@ void DogfightState::think()
 		// can't be done in the constructor (recoloring the ammo text doesn't work)
 		for (int i = 0; i < _weaponNum; ++i)
 		{
-			if (_craft->getWeapons()->at(i) && !_weaponEnabled[i])
+			if (_craft->getWeapons()->at(i) && !_sim->isWeaponEnabled(i))
 			{
-				recolor(i, _weaponEnabled[i]);
+				recolor(i, false);
 			}
 		}
 		_delayedRecolorDone = true;
@@ -915,20 +833,16 @@ void DogfightState::animate()
 	}
 
 	// Draw projectiles.
-	for (auto* cwp : _projectiles)
+	for (auto& cwp : _sim->getProjectiles())
 	{
-		drawProjectile(cwp);
+		drawProjectile(&cwp);
 	}
 
-	// Clears text after a while
-	if (_timeout == 0)
+	// Clears text after a while, the simulator counts it down
+	if (_sim->getStatusTimeout() == 0)
 	{
 		_txtStatus->setText("");
 	}
-	else
-	{
-		_timeout--;
-	}
 
 	// Animate UFO hit.
 	bool lastHitAnimFrame = false;
@@ -956,7 +870,6 @@ void DogfightState::animate()
  */
 void DogfightState::update()
 {
-	bool finalRun = false;
 	// Check if craft is not low on fuel when window minimized, and
 	// Check if crafts destination hasn't been changed when window minimized.
 	if (!_ufoIsAttacking)
@@ -972,992 +885,477 @@ void DogfightState::update()
 	if (!_minimized)
 	{
 		animate();
-		if (!_ufo->isCrashed() && !_ufo->isDestroyed() && !_craft->isDestroyed() && !_ufo->getInterceptionProcessed())
-		{
-			_ufo->setInterceptionProcessed(true);
-			int escapeCounter = _ufo->getEscapeCountdown();
-			if (_ufoIsAttacking)
-			{
-				if (_disableDisengage && _ufo->getSoftlockShotCounter() >= _ufo->getRules()->getSoftlockThreshold())
-				{
-					escapeCounter = 1; // game is in softlock, stop being a hunter-killer and disengage!
-				}
-				else if (_ufo->getDamage() > _ufo->getCraftStats().damageMax / 3 && _ufo->getHuntBehavior() != 1)
-				{
-					// TODO: rethink: unhardcode run away thresholds?
-					if (_craft->getDamage() > _craft->getDamageMax() / 2)
-					{
-						escapeCounter = 999; // it's gonna be tight, continue shooting...
-					}
-					else
-					{
-						escapeCounter = 1; // we're badly hurt and xcom isn't, abort immediately!
-					}
-				}
-				else
-				{
-					escapeCounter = 999; // we're still ok, continue shooting...
-				}
-			}
-
-			if (escapeCounter > 0)
-			{
-				escapeCounter--;
-				_ufo->setEscapeCountdown(escapeCounter);
-				// Check if UFO is breaking off.
-				if (escapeCounter == 0)
-				{
-					_ufo->setSpeed(_ufo->getCraftStats().speedMax);
-					if (_ufoIsAttacking && _ufo->isHunterKiller())
-					{
-						// stop being a hunter-killer and run away!
-						_ufo->resetOriginalDestination(_craft);
-						_ufo->setHunterKiller(false);
-					}
-				}
-			}
-			if (_ufo->getFireCountdown() > 0)
-			{
-				_ufo->setFireCountdown(_ufo->getFireCountdown() - 1);
-			}
-		}
-	}
-	// Crappy craft is chasing UFO.
-	int speedMinusTractors = std::max(0, _ufo->getSpeed() - _ufo->getTractorBeamSlowdown());
-	if (speedMinusTractors > _craft->getCraftStats().speedMax)
-	{
-		if (!_ufoIsAttacking || !_ufo->isHunterKiller())
-		{
-			_ufoBreakingOff = true;
-			finalRun = true;
-			setStatus("STR_UFO_OUTRUNNING_INTERCEPTOR");
-		}
-	}
-	else
-	{
-		_ufoBreakingOff = false;
 	}
 
-	bool projectileInFlight = false;
+	// other interceptions of this UFO may have changed it since the last update
+	_sim->loadFromGame(_craft, _ufo);
+	bool battleOver = _sim->tick();
+	_sim->saveToGame(_craft, _ufo);
+
 	if (!_minimized)
 	{
-		int distanceChange = 0;
-
-		// Update distance
-		if (!_ufoBreakingOff)
-		{
-			if (_currentDist < _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
-			{
-				distanceChange = 2 * _craftAccelerationBonus; // disengage speed
-				if (_currentDist + distanceChange >_targetDist)
-				{
-					distanceChange = _targetDist - _currentDist;
-				}
-			}
-			else if (_currentDist > _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
-			{
-				distanceChange = -1 * _pilotApproachSpeedModifier; // engage speed
-			}
-
-			// don't let the interceptor mystically push or pull its fired projectiles
-			for (auto* cwp : _projectiles)
-			{
-				if (cwp->getGlobalType() != CWPGT_BEAM && cwp->getDirection() == D_UP)
-				{
-					cwp->setPosition(cwp->getPosition() + distanceChange);
-				}
-			}
-		}
-		else
-		{
-			distanceChange = 4; // ufo breaking off speed
-
-			// UFOs can try to outrun our missiles, don't adjust projectile positions here
-			// If UFOs ever fire anything but beams, those positions need to be adjust here though.
-		}
-
-		_currentDist += distanceChange;
-
 		if (_game->getMod()->getShowDogfightDistanceInKm())
 		{
-			_txtDistance->setText(tr("STR_KILOMETERS").arg(_currentDist / 8));
+			_txtDistance->setText(tr("STR_KILOMETERS").arg(_sim->getDistance() / 8));
 		}
 		else
 		{
 			std::ostringstream ss;
-			ss << _currentDist;
+			ss << _sim->getDistance();
 			_txtDistance->setText(ss.str());
 		}
+	}
 
-		// Check and recharge craft shields
-		// Check if the UFO's shields are being handled by an interception window
-		if (_ufo->getShieldRechargeHandle() == 0)
-		{
-			_ufo->setShieldRechargeHandle(_interceptionNumber);
-		}
-
-		// UFO shields
-		if ((_ufo->getShield() != 0) && (_interceptionNumber == _ufo->getShieldRechargeHandle()))
-		{
-			int total = _ufo->getCraftStats().shieldRecharge / 100;
-			if (RNG::percent(_ufo->getCraftStats().shieldRecharge % 100))
-				total++;
-			_ufo->setShield(_ufo->getShield() + total);
-		}
-
-		// Player craft shields
-		if (_craft->getShield() != 0)
+	// Check when battle is over.
+	if (battleOver)
+	{
+		if (_sim->isUfoBreakingOff())
 		{
-			int total = _craft->getCraftStats().shieldRecharge / 100;
-			if (RNG::percent(_craft->getCraftStats().shieldRecharge % 100))
-				total++;
-			if (total != 0)
+			_ufo->move();
+			// TODO: rethink: give hunter-killers opportunity to escape?
+			if (!_ufoIsAttacking)
 			{
-				_craft->setShield(_craft->getShield() + total);
-				drawCraftShield();
+				_craft->setDestination(_ufo);
 			}
 		}
-
-		// Is the craft itself a projectile?
-		if (_missileCraft && !_missileImpact && !_craft->isDestroyed())
+		if (!_destroyCraft && (_destroyUfo || _mode == _btnDisengage))
 		{
-			if (_currentDist <= AGGRESSIVE_DIST) // Note: hard-coded distance, ok
+			// keep original target if attacked by a HK (and didn't disengage manually)
+			bool keepOriginalTarget = _ufoIsAttacking && _craft->getDestination() != _ufo;
+			if (!keepOriginalTarget || _mode == _btnDisengage)
 			{
-				_missileImpact = true;
-
-				// Missile self-destruct
-				_craft->setDamage(_craft->getCraftStats().damageMax);
-				drawCraftDamage();
-
-				// Handle UFO shields
-				int damage = _craft->getRules()->missilePower(); // Note: no randomness :(
-				int shieldDamage = 0;
-				if (_ufo->getShield() != 0)
-				{
-					shieldDamage = damage; // Note: no shield-effectiveness factor
-					// scale down by bleed-through factor
-					damage = std::max(0, shieldDamage - _ufo->getShield()) * _ufo->getCraftStats().shieldBleedThrough;
-					_ufo->setShield(_ufo->getShield() - shieldDamage);
-				}
-				damage = std::max(0, damage - _ufo->getCraftStats().armor);
-				_ufo->setDamage(_ufo->getDamage() + damage, _game->getMod());
-				_state->handleDogfightExperience(); // called after setDamage
-				if (_ufo->isCrashed())
-				{
-					_ufo->setShotDownByCraftId(_craft->getUniqueId());
-					_ufo->setSpeed(0);
-					_ufo->setDestination(0);
-					// if the ufo got destroyed here, these no longer apply
-					_ufoBreakingOff = false;
-					finalRun = false;
-					_end = false;
-				}
-				if (_ufo->getHitFrame() == 0)
-				{
-					_animatingHit = true;
-					_ufo->setHitFrame(3);
-				}
-				// How hard was the ufo hit?
-				if (_ufo->getShield() != 0)
-				{
-					setStatus("STR_UFO_SHIELD_HIT");
-				}
-				else
-				{
-					if (damage == 0)
-					{
-						if (shieldDamage == 0)
-							setStatus("STR_UFO_HIT_NO_DAMAGE");
-						else
-							setStatus("STR_UFO_SHIELD_DOWN");
-					}
-					else
-					{
-						if (damage < _ufo->getCraftStats().damageMax / 2 * _game->getMod()->getUfoGlancingHitThreshold() / 100)
-							setStatus("STR_UFO_HIT_GLANCING");
-						else
-							setStatus("STR_UFO_HIT");
-					}
-				}
-				_game->getMod()->getSound("GEO.CAT", Mod::UFO_HIT)->play();
+				_craft->returnToBase();
 			}
-		}
 
-		// Move projectiles and check for hits.
-		for (auto* p : _projectiles)
-		{
-			p->move();
-			// Projectiles fired by interceptor.
-			if (p->getDirection() == D_UP)
-			{
-				// Projectile reached the UFO - determine if it's been hit.
-				if (((p->getPosition() >= _currentDist) || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved())) && !_ufo->isCrashed() && !p->getMissed())
-				{
-					// UFO hit.
-					int chanceToHit = (p->getAccuracy() * (100 + 300 / (5 - _ufoSize)) + 100) / 200; // vanilla xcom
-					chanceToHit -= _ufo->getCraftStats().avoidBonus;
-					chanceToHit += _craft->getCraftStats().hitBonus;
-					chanceToHit += _pilotAccuracyBonus;
-					if (RNG::percent(chanceToHit))
-					{
-						// Formula delivered by Volutar, altered by Extended version.
-						int power = p->getDamage() * (_craft->getCraftStats().powerBonus + 100) / 100;
-
-						// Handle UFO shields
-						int damage = RNG::generate(power / 2, power);
-						int shieldDamage = 0;
-						if (_ufo->getShield() != 0)
-						{
-							shieldDamage = damage * p->getShieldDamageModifier() / 100;
-							if (p->getShieldDamageModifier() == 0)
-							{
-								damage = 0;
-							}
-							else
-							{
-								// scale down by bleed-through factor and scale up by shield-effectiveness factor
-								damage = std::max(0, shieldDamage - _ufo->getShield()) * _ufo->getCraftStats().shieldBleedThrough / p->getShieldDamageModifier();
-							}
-							_ufo->setShield(_ufo->getShield() - shieldDamage);
-						}
-
-						damage = std::max(0, damage - _ufo->getCraftStats().armor);
-						_ufo->setDamage(_ufo->getDamage() + damage, _game->getMod());
-						_state->handleDogfightExperience(); // called after setDamage
-						if (_ufo->isCrashed())
-						{
-							_ufo->setShotDownByCraftId(_craft->getUniqueId());
-							_ufo->setSpeed(0);
-							_ufo->setDestination(0);
-							// if the ufo got destroyed here, these no longer apply
-							_ufoBreakingOff = false;
-							finalRun = false;
-							_end = false;
-						}
-						if (_ufo->getHitFrame() == 0)
-						{
-							_animatingHit = true;
-							_ufo->setHitFrame(3);
-						}
-
-						// How hard was the ufo hit?
-						if (_ufo->getShield() != 0)
-						{
-							setStatus("STR_UFO_SHIELD_HIT");
-						}
-						else
-						{
-							if (damage == 0)
-							{
-								if (shieldDamage == 0)
-								{
-									setStatus("STR_UFO_HIT_NO_DAMAGE");
-								}
-								else
-								{
-									setStatus("STR_UFO_SHIELD_DOWN");
-								}
-							}
-							else
-							{
-								if (damage < _ufo->getCraftStats().damageMax / 2 * _game->getMod()->getUfoGlancingHitThreshold() / 100)
-								{
-									setStatus("STR_UFO_HIT_GLANCING");
-								}
-								else
-								{
-									setStatus("STR_UFO_HIT");
-								}
-							}
-						}
-
-						_game->getMod()->getSound("GEO.CAT", Mod::UFO_HIT)->play();
-						p->remove();
-					}
-					// Missed.
-					else
-					{
-						if (p->getGlobalType() == CWPGT_BEAM)
-						{
-							p->remove();
-						}
-						else
-						{
-							p->setMissed(true);
-						}
-					}
-				}
-				// Check if projectile passed it's maximum range.
-				if (p->getGlobalType() == CWPGT_MISSILE && p->getPosition() / 8 >= p->getRange())
-				{
-					p->remove();
-				}
-				else if (!_ufo->isCrashed())
-				{
-					projectileInFlight = true;
-				}
-			}
-			// Projectiles fired by UFO.
-			else if (p->getDirection() == D_DOWN)
+			// Need to give the craft at least one step advantage over the hunter-killer (to be able to escape)
+			if (_ufoIsAttacking)
 			{
-				if (p->getGlobalType() == CWPGT_MISSILE || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved()))
+				bool returnedToBase = _craft->think();
+				if (returnedToBase)
 				{
-					int chancetoHit = p->getAccuracy(); // vanilla xcom
-					chancetoHit -= _craft->getCraftStats().avoidBonus;
-					chancetoHit += _ufo->getCraftStats().hitBonus;
-					chancetoHit -= _pilotDodgeBonus;
-					// evasive maneuvers
-					if (_ufoIsAttacking && _mode == _btnCautious)
-					{
-						// HK's chance to hit is halved, but craft's reload time is doubled too
-						chancetoHit = chancetoHit / 2;
-					}
-					if (RNG::percent(chancetoHit) || _selfDestructPressed)
-					{
-						// Formula delivered by Volutar, altered by Extended version.
-						int power = p->getDamage() * (_ufo->getCraftStats().powerBonus + 100) / 100;
-						int damage = RNG::generate(0, power);
-
-						if (_craft->getShield() != 0)
-						{
-							int shieldBleedThroughDamage = std::max(0, damage - _craft->getShield()) * _craft->getCraftStats().shieldBleedThrough / 100;
-							_craft->setShield(_craft->getShield() - damage);
-							damage = shieldBleedThroughDamage;
-							drawCraftShield();
-							setStatus("STR_INTERCEPTOR_SHIELD_HIT");
-						}
-
-						damage = std::max(0, damage - _craft->getCraftStats().armor);
-
-						// if a totally crappy HK is attacking a completely defenseless craft, avoid endless fight
-						if (_selfDestructPressed)
-						{
-							damage = _craft->getCraftStats().damageMax;
-						}
-
-						if (damage)
-						{
-							_craft->setDamage(_craft->getDamage() + damage);
-							drawCraftDamage();
-							if (_missileCraft)
-								setStatus("STR_MISSILE_DAMAGED");
-							else
-								setStatus("STR_INTERCEPTOR_DAMAGED");
-							_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_HIT)->play(); //10
-							if (_mode == _btnCautious && _craft->getDamagePercentage() >= 50 && !_ufoIsAttacking)
-							{
-								_targetDist = STANDOFF_DIST;
-							}
-						}
-					}
-					p->remove();
+					_game->getSavedGame()->stopHuntingXcomCraft(_craft); // hiding in the base is good enough, obviously
 				}
 			}
 		}
-
-		// Remove projectiles that hit or missed their target.
-		Collections::deleteIf(_projectiles, _projectiles.size(),
-			[&](CraftWeaponProjectile* cwp)
-			{
-				return cwp->toBeRemoved() == true || (cwp->getMissed() == true && cwp->getPosition() <= 0);
-			}
-		);
-
-		// Check if the situation is hopeless for the craft
-		if (_disableDisengage && !_craftIsDefenseless && !_missileCraft)
+		if (_ufo->isCrashed())
 		{
-			if (_projectiles.empty())
+			for (auto* follower : _ufo->getCraftFollowers())
 			{
-				bool hasNoAmmo = true;
-				for (auto* cw : *_craft->getWeapons())
-				{
-					if (cw && cw->getAmmo() > 0)
-					{
-						hasNoAmmo = false;
-						break;
-					}
-				}
-				// no projectiles in the air and no ammo left
-				if (hasNoAmmo)
+				if (follower->getNumTotalUnits() == 0 || !follower->getRules()->getAllowLanding())
 				{
-					_craftIsDefenseless = true;
-
-					// self-destruct button
-					int offset = _game->getMod()->getInterface("dogfight")->getElement("minimizeButtonDummy")->TFTDMode ? 1 : 0;
-					_btnMinimize->drawRect(1 + offset, 1, _btnMinimize->getWidth() - 2 - offset, _btnMinimize->getHeight() - 2, _colors[DAMAGE_MAX]);
-					_btnMinimize->setVisible(true);
+					follower->returnToBase();
 				}
 			}
 		}
+		endDogfight();
+	}
+}
 
-		// Handle weapons and craft distance.
-		for (int i = 0; i < _weaponNum; ++i)
+/**
+ * Shows what just happened in the combat and applies it to the game,
+ * while the simulator's tick is still running so the game reacts
+ * (and draws random numbers) in the same order as the combat.
+ * @param event What happened.
+ * @param value Weapon slot or damage, depending on the event.
+ * @param extra Shield damage, depending on the event.
+ */
+void DogfightState::dogfightEvent(DogfightEvent event, int value, int extra)
+{
+	const DogfightSetup &state = _sim->getState();
+	switch (event)
+	{
+	case DFE_UFO_ESCAPING:
+		_ufo->setSpeed(state.ufoSpeed);
+		if (_ufoIsAttacking && _ufo->isHunterKiller())
+		{
+			// stop being a hunter-killer and run away!
+			_ufo->resetOriginalDestination(_craft);
+			_ufo->setHunterKiller(false);
+		}
+		break;
+	case DFE_UFO_OUTRUNNING:
+		setStatus("STR_UFO_OUTRUNNING_INTERCEPTOR");
+		break;
+	case DFE_CRAFT_SHIELD_RECHARGED:
+		_craft->setShield(state.craftShield);
+		drawCraftShield();
+		break;
+	case DFE_MISSILE_IMPACT:
+		// Missile self-destruct
+		_craft->setDamage(state.craftDamage);
+		drawCraftDamage();
+		break;
+	case DFE_UFO_HIT:
+		_ufo->setShield(state.ufoShield);
+		_ufo->setDamage(_ufo->getDamage() + value, _game->getMod());
+		_state->handleDogfightExperience(); // called after setDamage
+		if (_ufo->isCrashed())
 		{
-			CraftWeapon *w = _craft->getWeapons()->at(i);
-			if (w == 0 || _missileCraft)
-			{
-				continue;
-			}
-			int wTimer = _weaponFireCountdown[i];
-
-			// Handle weapon firing
-			if (wTimer == 0 && _currentDist <= w->getRules()->getRange() * 8 && w->getAmmo() > 0 && _mode != _btnStandoff
-				&& _mode != _btnDisengage && !_ufo->isCrashed() && !_craft->isDestroyed())
-			{
-				if (_weaponEnabled[i])
-				{
-					fireWeapon(i);
-					projectileInFlight = true;
-				}
-			}
-			else if (wTimer > 0)
-			{
-				--_weaponFireCountdown[i];
-			}
+			_ufo->setShotDownByCraftId(_craft->getUniqueId());
+			_ufo->setSpeed(0);
+			_ufo->setDestination(0);
+		}
+		if (_ufo->getHitFrame() == 0)
+		{
+			_animatingHit = true;
+			_ufo->setHitFrame(3);
+		}
 
-			// Handle craft tractor beams
-			if (w->getRules()->getTractorBeamPower() != 0)
+		// How hard was the ufo hit?
+		if (_ufo->getShield() != 0)
+		{
+			setStatus("STR_UFO_SHIELD_HIT");
+		}
+		else
+		{
+			if (value == 0)
 			{
-				if (_currentDist <= w->getRules()->getRange() * 8 && _mode != _btnStandoff
-					&& _mode != _btnDisengage && !_ufo->isCrashed() && !_craft->isDestroyed()
-					&& _weaponEnabled[i])
+				if (extra == 0)
 				{
-					if (!_tractorLockedOn[i])
-					{
-						_tractorLockedOn[i] = true;
-						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
-						tractorBeamSlowdown += w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
-						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
-						setStatus("STR_TRACTOR_BEAM_ENGAGED");
-					}
+					setStatus("STR_UFO_HIT_NO_DAMAGE");
 				}
 				else
 				{
-					if (_tractorLockedOn[i])
-					{
-						_tractorLockedOn[i] = false;
-						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
-						tractorBeamSlowdown -= w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
-						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
-						setStatus("STR_TRACTOR_BEAM_DISENGAGED");
-					}
+					setStatus("STR_UFO_SHIELD_DOWN");
 				}
 			}
-
-			if (w->getAmmo() == 0 && !projectileInFlight && !_craft->isDestroyed())
+			else
 			{
-				// Handle craft distance according to option set by user and available ammo.
-				if (_mode == _btnCautious && !_ufoIsAttacking)
+				if (value < _ufo->getCraftStats().damageMax / 2 * _game->getMod()->getUfoGlancingHitThreshold() / 100)
 				{
-					minimumDistance();
+					setStatus("STR_UFO_HIT_GLANCING");
 				}
-				else if (_mode == _btnStandard)
+				else
 				{
-					maximumDistance();
+					setStatus("STR_UFO_HIT");
 				}
 			}
 		}
+		_game->getMod()->getSound("GEO.CAT", Mod::UFO_HIT)->play();
+		break;
+	case DFE_CRAFT_SHIELD_HIT:
+		_craft->setShield(state.craftShield);
+		drawCraftShield();
+		setStatus("STR_INTERCEPTOR_SHIELD_HIT");
+		break;
+	case DFE_CRAFT_HIT:
+		_craft->setDamage(state.craftDamage);
+		drawCraftDamage();
+		if (_missileCraft)
+			setStatus("STR_MISSILE_DAMAGED");
+		else
+			setStatus("STR_INTERCEPTOR_DAMAGED");
+		_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_HIT)->play(); //10
+		break;
+	case DFE_CRAFT_DEFENSELESS:
+		{
+			// self-destruct button
+			int offset = _game->getMod()->getInterface("dogfight")->getElement("minimizeButtonDummy")->TFTDMode ? 1 : 0;
+			_btnMinimize->drawRect(1 + offset, 1, _btnMinimize->getWidth() - 2 - offset, _btnMinimize->getHeight() - 2, _colors[DAMAGE_MAX]);
+			_btnMinimize->setVisible(true);
+		}
+		break;
+	case DFE_WEAPON_FIRED:
+		{
+			CraftWeapon *w = _craft->getWeapons()->at(value);
+			w->setAmmo(state.weapons[value].ammo);
+
+			std::ostringstream ss;
+			ss << w->getAmmo();
+			_txtAmmo[value]->setText(ss.str());
 
-		// Handle UFO firing.
-		if (_currentDist <= _ufo->getRules()->getWeaponRange() * 8 && !_ufo->isCrashed() && !_craft->isDestroyed())
+			_game->getMod()->getSound("GEO.CAT", w->getRules()->getSound())->play();
+			_firedAtLeastOnce = true;
+		}
+		break;
+	case DFE_TRACTOR_BEAM_ENGAGED:
+		_ufo->setTractorBeamSlowdown(state.ufoTractorBeamSlowdown);
+		setStatus("STR_TRACTOR_BEAM_ENGAGED");
+		break;
+	case DFE_TRACTOR_BEAM_DISENGAGED:
+		_ufo->setTractorBeamSlowdown(state.ufoTractorBeamSlowdown);
+		setStatus("STR_TRACTOR_BEAM_DISENGAGED");
+		break;
+	case DFE_UFO_FIRED:
+		_ufo->setFireCountdown(state.ufoFireCountdown);
+		setStatus("STR_UFO_RETURN_FIRE");
+		if (_ufoIsAttacking && _disableDisengage)
+		{
+			_ufo->increaseSoftlockShotCounter();
+		}
+		if (_ufo->getRules()->getFireSound() == -1)
 		{
-			if (_ufo->getShootingAt() == 0)
+			_game->getMod()->getSound("GEO.CAT", Mod::UFO_FIRE)->play();
+		}
+		else
+		{
+			_game->getMod()->getSound("GEO.CAT", _ufo->getRules()->getFireSound())->play();
+		}
+		break;
+	case DFE_CRAFT_DESTROYED:
+		// End dogfight if craft is destroyed.
+		if (_missileCraft)
+		{
+			if (value)
 			{
-				_ufo->setShootingAt(_interceptionNumber);
+				// Empty by design
+				// Let's keep showing how much damage was done to the UFO (and/or shields)
+				// No need to say the missile impacted/self-destructed, it's obvious
 			}
-			if (_ufo->getShootingAt() == _interceptionNumber)
+			else
 			{
-				if (_ufo->getFireCountdown() == 0)
-				{
-					ufoFireWeapon();
-				}
+				setStatus("STR_MISSILE_DESTROYED");
 			}
 		}
-		else if (_ufo->getShootingAt() == _interceptionNumber)
+		else
 		{
-			_ufo->setShootingAt(0);
+			setStatus("STR_INTERCEPTOR_DESTROYED");
 		}
+		if (_ufoIsAttacking)
+		{
+			// Note: this was moved to GeoscapeState.cpp, as it is not 100% reliable here
+			//_craft->evacuateCrew(_game->getMod());
+		}
+		_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_EXPLODE)->play();
+		_destroyCraft = true;
+		_ufo->setShootingAt(0);
+		break;
 	}
+}
 
-	// Check when battle is over.
-	if (_end == true && (((_currentDist > 640 || _minimized) && (_mode == _btnDisengage || _ufoBreakingOff == true)) || (_timeout == 0 && (_ufo->isCrashed() || _craft->isDestroyed()))))
+/**
+ * Handles the UFO going down: the alien mission, retaliation,
+ * scoring, and where (and whether) the UFO comes to rest.
+ * @param forcedDown Was it brought down by tractor beams?
+ * @return True if the UFO was lost on the way down.
+ */
+bool DogfightState::dogfightUfoDown(bool forcedDown)
+{
+	if (forcedDown)
 	{
-		if (_ufoBreakingOff)
+		bool survived = true;
+		if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
 		{
-			_ufo->move();
-			// TODO: rethink: give hunter-killers opportunity to escape?
-			if (!_ufoIsAttacking)
+			survived = false; // destroyed on real water
+		}
+		else
+		{
+			bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
+			if (fakeUnderwaterTexture && !RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
 			{
-				_craft->setDestination(_ufo);
+				survived = false; // destroyed on fake water
 			}
 		}
-		if (!_destroyCraft && (_destroyUfo || _mode == _btnDisengage))
+		if (_ufo->getRules()->isUnmanned())
 		{
-			// keep original target if attacked by a HK (and didn't disengage manually)
-			bool keepOriginalTarget = _ufoIsAttacking && _craft->getDestination() != _ufo;
-			if (!keepOriginalTarget || _mode == _btnDisengage)
+			survived = false; // unmanned UFOs (drones, missiles, etc.) can't be forced to land
+		}
+		if (!survived) // Brought it down over water (and didn't survive splashdown)
+		{
+			_ufo->setDamage(_ufo->getCraftStats().damageMax, _game->getMod());
+			_state->handleDogfightExperience(); // called after setDamage
+			_ufo->setShotDownByCraftId(_craft->getUniqueId());
+			_ufo->setSpeed(0);
+			_ufo->setStatus(Ufo::DESTROYED);
+			_destroyUfo = true;
+			for (auto* country : *_game->getSavedGame()->getCountries())
 			{
-				_craft->returnToBase();
+				if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
+				{
+					country->addActivityXcom(_ufo->getRules()->getScore());
+					break;
+				}
 			}
-
-			// Need to give the craft at least one step advantage over the hunter-killer (to be able to escape)
-			if (_ufoIsAttacking)
+			for (auto* region : *_game->getSavedGame()->getRegions())
 			{
-				bool returnedToBase = _craft->think();
-				if (returnedToBase)
+				if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
 				{
-					_game->getSavedGame()->stopHuntingXcomCraft(_craft); // hiding in the base is good enough, obviously
+					region->addActivityXcom(_ufo->getRules()->getScore());
+					break;
 				}
 			}
 		}
-		if (_ufo->isCrashed())
+		else // Brought it down over land (or survived splashdown)
 		{
-			for (auto* follower : _ufo->getCraftFollowers())
+			_ufo->setSecondsRemaining(RNG::generate(30, 120)*60);
+			_ufo->setShootingAt(0);
+			_ufo->setStatus(Ufo::LANDED);
+			_ufo->setAltitude("STR_GROUND");
+			_ufo->setSpeed(0);
+			_ufo->setTractorBeamSlowdown(0);
+			if (_ufo->getLandId() == 0)
 			{
-				if (follower->getNumTotalUnits() == 0 || !follower->getRules()->getAllowLanding())
-				{
-					follower->returnToBase();
-				}
+				_ufo->setLandId(_game->getSavedGame()->getId("STR_LANDING_SITE"));
 			}
 		}
-		endDogfight();
+		return !survived;
 	}
 
-	if (_currentDist > 640 && _ufoBreakingOff)
+	if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
 	{
-		finalRun = true;
-	}
-
-	if (!_end)
-	{
-		if (_endCraftHandled)
-		{
-			finalRun = true;
-		}
-		else if (_craft->isDestroyed())
+		AlienRace *race = _game->getMod()->getAlienRace(_ufo->getAlienRace());
+		AlienMission *mission = _ufo->getMission();
+		mission->ufoShotDown(*_ufo);
+		// Check for retaliation trigger.
+		int retaliationOdds = mission->getRules().getRetaliationOdds();
+		if (retaliationOdds == -1)
 		{
-			// End dogfight if craft is destroyed.
-			if (_missileCraft)
+			retaliationOdds = 100 - (4 * (24 - _game->getSavedGame()->getDifficultyCoefficient()) - race->getRetaliationAggression());
 			{
-				if (_missileImpact)
-				{
-					// Empty by design
-					// Let's keep showing how much damage was done to the UFO (and/or shields)
-					// No need to say the missile impacted/self-destructed, it's obvious
-				}
-				else
+				int diff = _game->getSavedGame()->getDifficulty();
+				auto& custom = _game->getMod()->getRetaliationTriggerOdds();
+				if (custom.size() > (size_t)diff)
 				{
-					setStatus("STR_MISSILE_DESTROYED");
+					retaliationOdds = custom[diff] + race->getRetaliationAggression();
 				}
 			}
-			else
-			{
-				setStatus("STR_INTERCEPTOR_DESTROYED");
-			}
-			if (_ufoIsAttacking)
-			{
-				// Note: this was moved to GeoscapeState.cpp, as it is not 100% reliable here
-				//_craft->evacuateCrew(_game->getMod());
-			}
-			_timeout += 30;
-			_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_EXPLODE)->play();
-			finalRun = true;
-			_destroyCraft = true;
-			_endCraftHandled = true;
-			_ufo->setShootingAt(0);
 		}
-
-		if (_endUfoHandled)
+		// Have mercy on beginners
+		if (_game->getSavedGame()->getMonthsPassed() < Mod::DIFFICULTY_BASED_RETAL_DELAY[_game->getSavedGame()->getDifficulty()])
 		{
-			finalRun = true;
+			retaliationOdds = 0;
 		}
-		else if (_ufo->isCrashed())
-		{
-			// End dogfight if UFO is crashed or destroyed.
-			_endUfoHandled = true;
 
-			if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+		if (RNG::percent(retaliationOdds))
+		{
+			// Spawn retaliation mission.
+			std::string targetRegion;
+			int retaliationUfoMissionRegionOdds = 50 - 6 * _game->getSavedGame()->getDifficultyCoefficient();
 			{
-				AlienRace *race = _game->getMod()->getAlienRace(_ufo->getAlienRace());
-				AlienMission *mission = _ufo->getMission();
-				mission->ufoShotDown(*_ufo);
-				// Check for retaliation trigger.
-				int retaliationOdds = mission->getRules().getRetaliationOdds();
-				if (retaliationOdds == -1)
-				{
-					retaliationOdds = 100 - (4 * (24 - _game->getSavedGame()->getDifficultyCoefficient()) - race->getRetaliationAggression());
-					{
-						int diff = _game->getSavedGame()->getDifficulty();
-						auto& custom = _game->getMod()->getRetaliationTriggerOdds();
-						if (custom.size() > (size_t)diff)
-						{
-							retaliationOdds = custom[diff] + race->getRetaliationAggression();
-						}
-					}
-				}
-				// Have mercy on beginners
-				if (_game->getSavedGame()->getMonthsPassed() < Mod::DIFFICULTY_BASED_RETAL_DELAY[_game->getSavedGame()->getDifficulty()])
-				{
-					retaliationOdds = 0;
-				}
-
-				if (RNG::percent(retaliationOdds))
+				int diff = _game->getSavedGame()->getDifficulty();
+				auto& custom = _game->getMod()->getRetaliationBaseRegionOdds();
+				if (custom.size() > (size_t)diff)
 				{
-					// Spawn retaliation mission.
-					std::string targetRegion;
-					int retaliationUfoMissionRegionOdds = 50 - 6 * _game->getSavedGame()->getDifficultyCoefficient();
-					{
-						int diff = _game->getSavedGame()->getDifficulty();
-						auto& custom = _game->getMod()->getRetaliationBaseRegionOdds();
-						if (custom.size() > (size_t)diff)
-						{
-							retaliationUfoMissionRegionOdds = 100 - custom[diff];
-						}
-					}
-					if (RNG::percent(retaliationUfoMissionRegionOdds))
-					{
-						// Attack on UFO's mission region
-						targetRegion = _ufo->getMission()->getRegion();
-					}
-					else
-					{
-						// Try to find and attack the originating base.
-						targetRegion = _game->getSavedGame()->locateRegion(*_craft->getBase())->getRules()->getType();
-						// TODO: If the base is removed, the mission is canceled.
-					}
-					// Difference from original: No retaliation until final UFO lands (Original: Is spawned).
-					if (!_game->getSavedGame()->findAlienMission(targetRegion, OBJECTIVE_RETALIATION, race))
-					{
-						auto* retalWeights = race->retaliationMissionWeights(_game->getSavedGame()->getMonthsPassed());
-						std::string retalMission = retalWeights ? retalWeights->choose() : "";
-						const RuleAlienMission *rule = _game->getMod()->getAlienMission(retalMission, false);
-						if (!rule)
-						{
-							rule = _game->getMod()->getRandomMission(OBJECTIVE_RETALIATION, _game->getSavedGame()->getMonthsPassed());
-						}
-
-						if (rule)
-						{
-							AlienMission *newMission = new AlienMission(*rule);
-							newMission->setId(_game->getSavedGame()->getId("ALIEN_MISSIONS"));
-							newMission->setRegion(targetRegion, *_game->getMod());
-							newMission->setRace(_ufo->getAlienRace());
-							newMission->start(*_game, *_state->getGlobe(), newMission->getRules().getWave(0).spawnTimer); // fixed delay for first scout
-							_game->getSavedGame()->getAlienMissions().push_back(newMission);
-						}
-					}
+					retaliationUfoMissionRegionOdds = 100 - custom[diff];
 				}
 			}
-
-			if (_ufo->isDestroyed())
+			if (RNG::percent(retaliationUfoMissionRegionOdds))
 			{
-				if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
-				{
-					for (auto* country : *_game->getSavedGame()->getCountries())
-					{
-						if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							country->addActivityXcom(_ufo->getRules()->getScore()*2);
-							break;
-						}
-					}
-					for (auto* region : *_game->getSavedGame()->getRegions())
-					{
-						if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							region->addActivityXcom(_ufo->getRules()->getScore()*2);
-							break;
-						}
-					}
-					setStatus("STR_UFO_DESTROYED");
-					_game->getMod()->getSound("GEO.CAT", Mod::UFO_EXPLODE)->play(); //11
-				}
-				_destroyUfo = true;
+				// Attack on UFO's mission region
+				targetRegion = _ufo->getMission()->getRegion();
 			}
 			else
 			{
-				if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
-				{
-					setStatus("STR_UFO_CRASH_LANDS");
-					_game->getMod()->getSound("GEO.CAT", Mod::UFO_CRASH)->play(); //10
-					for (auto* country : *_game->getSavedGame()->getCountries())
-					{
-						if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							country->addActivityXcom(_ufo->getRules()->getScore());
-							break;
-						}
-					}
-					for (auto* region : *_game->getSavedGame()->getRegions())
-					{
-						if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							region->addActivityXcom(_ufo->getRules()->getScore());
-							break;
-						}
-					}
-				}
-				bool survived = true;
-				bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
-				if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
-				{
-					survived = false; // destroyed on real water
-				}
-				else if (fakeUnderwaterTexture)
-				{
-					if (RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
-					{
-						setStatus("STR_UFO_SURVIVED_SPLASHDOWN");
-					}
-					else
-					{
-						survived = false; // destroyed on fake water
-						setStatus("STR_UFO_DESTROYED_BY_SPLASHDOWN");
-					}
-				}
-				if (!survived)
+				// Try to find and attack the originating base.
+				targetRegion = _game->getSavedGame()->locateRegion(*_craft->getBase())->getRules()->getType();
+				// TODO: If the base is removed, the mission is canceled.
+			}
+			// Difference from original: No retaliation until final UFO lands (Original: Is spawned).
+			if (!_game->getSavedGame()->findAlienMission(targetRegion, OBJECTIVE_RETALIATION, race))
+			{
+				auto* retalWeights = race->retaliationMissionWeights(_game->getSavedGame()->getMonthsPassed());
+				std::string retalMission = retalWeights ? retalWeights->choose() : "";
+				const RuleAlienMission *rule = _game->getMod()->getAlienMission(retalMission, false);
+				if (!rule)
 				{
-					_ufo->setStatus(Ufo::DESTROYED);
-					_destroyUfo = true;
+					rule = _game->getMod()->getRandomMission(OBJECTIVE_RETALIATION, _game->getSavedGame()->getMonthsPassed());
 				}
-				else
+
+				if (rule)
 				{
-					_ufo->setSecondsRemaining(RNG::generate(24, 96)*3600);
-					_ufo->setAltitude("STR_GROUND");
-					if (_ufo->getCrashId() == 0)
-					{
-						_ufo->setCrashId(_game->getSavedGame()->getId("STR_CRASH_SITE"));
-						if (_ufo->isHunterKiller())
-						{
-							// stop being a hunter-killer
-							_ufo->resetOriginalDestination(_craft);
-							_ufo->setHunterKiller(false);
-						}
-					}
+					AlienMission *newMission = new AlienMission(*rule);
+					newMission->setId(_game->getSavedGame()->getId("ALIEN_MISSIONS"));
+					newMission->setRegion(targetRegion, *_game->getMod());
+					newMission->setRace(_ufo->getAlienRace());
+					newMission->start(*_game, *_state->getGlobe(), newMission->getRules().getWave(0).spawnTimer); // fixed delay for first scout
+					_game->getSavedGame()->getAlienMissions().push_back(newMission);
 				}
 			}
-			_timeout += 30;
-			if (_ufo->getShotDownByCraftId() != _craft->getUniqueId())
-			{
-				_timeout += 50;
-				_ufo->setHitFrame(3);
-			}
-			finalRun = true;
-
-			if (_ufo->getStatus() == Ufo::LANDED)
-			{
-				_timeout += 30;
-				finalRun = true;
-				_ufo->setShootingAt(0);
-			}
 		}
-		else if (_ufo->getCraftStats().speedMax - _ufo->getTractorBeamSlowdown() == 0) // UFO brought down by tractor beam
-		{
-			_endUfoHandled = true;
+	}
 
-			bool survived = true;
-			if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
-			{
-				survived = false; // destroyed on real water
-			}
-			else
+	bool survived = true;
+	if (_ufo->isDestroyed())
+	{
+		if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+		{
+			for (auto* country : *_game->getSavedGame()->getCountries())
 			{
-				bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
-				if (fakeUnderwaterTexture && !RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
+				if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
 				{
-					survived = false; // destroyed on fake water
+					country->addActivityXcom(_ufo->getRules()->getScore()*2);
+					break;
 				}
 			}
-			if (_ufo->getRules()->isUnmanned())
+			for (auto* region : *_game->getSavedGame()->getRegions())
 			{
-				survived = false; // unmanned UFOs (drones, missiles, etc.) can't be forced to land
-			}
-			if (!survived) // Brought it down over water (and didn't survive splashdown)
-			{
-				finalRun = true;
-				_ufo->setDamage(_ufo->getCraftStats().damageMax, _game->getMod());
-				_state->handleDogfightExperience(); // called after setDamage
-				_ufo->setShotDownByCraftId(_craft->getUniqueId());
-				_ufo->setSpeed(0);
-				_ufo->setStatus(Ufo::DESTROYED);
-				_destroyUfo = true;
-				for (auto* country : *_game->getSavedGame()->getCountries())
+				if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
 				{
-					if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
-					{
-						country->addActivityXcom(_ufo->getRules()->getScore());
-						break;
-					}
+					region->addActivityXcom(_ufo->getRules()->getScore()*2);
+					break;
 				}
-				for (auto* region : *_game->getSavedGame()->getRegions())
+			}
+			setStatus("STR_UFO_DESTROYED");
+			_game->getMod()->getSound("GEO.CAT", Mod::UFO_EXPLODE)->play(); //11
+		}
+		_destroyUfo = true;
+	}
+	else
+	{
+		if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+		{
+			setStatus("STR_UFO_CRASH_LANDS");
+			_game->getMod()->getSound("GEO.CAT", Mod::UFO_CRASH)->play(); //10
+			for (auto* country : *_game->getSavedGame()->getCountries())
+			{
+				if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
 				{
-					if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
-					{
-						region->addActivityXcom(_ufo->getRules()->getScore());
-						break;
-					}
+					country->addActivityXcom(_ufo->getRules()->getScore());
+					break;
 				}
 			}
-			else // Brought it down over land (or survived splashdown)
+			for (auto* region : *_game->getSavedGame()->getRegions())
 			{
-				finalRun = true;
-				_ufo->setSecondsRemaining(RNG::generate(30, 120)*60);
-				_ufo->setShootingAt(0);
-				_ufo->setStatus(Ufo::LANDED);
-				_ufo->setAltitude("STR_GROUND");
-				_ufo->setSpeed(0);
-				_ufo->setTractorBeamSlowdown(0);
-				if (_ufo->getLandId() == 0)
+				if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
 				{
-					_ufo->setLandId(_game->getSavedGame()->getId("STR_LANDING_SITE"));
+					region->addActivityXcom(_ufo->getRules()->getScore());
+					break;
 				}
 			}
 		}
-	}
-
-	if (!projectileInFlight && finalRun)
-	{
-		_end = true;
-	}
-}
-
-/**
- * Fires a shot from the first weapon
- * equipped on the craft.
- */
-void DogfightState::fireWeapon(int i)
-{
-	CraftWeapon *w1 = _craft->getWeapons()->at(i);
-	if (w1->setAmmo(w1->getAmmo() - 1))
-	{
-		_weaponFireCountdown[i] = _weaponFireInterval[i];
-
-		std::ostringstream ss;
-		ss << w1->getAmmo();
-		_txtAmmo[i]->setText(ss.str());
-
-		CraftWeaponProjectile *p = w1->fire();
-		p->setDirection(D_UP);
-		p->setHorizontalPosition((i % 2 ? HP_RIGHT : HP_LEFT) * (1 + 2 * (i / 2)));
-		_projectiles.push_back(p);
-
-		_game->getMod()->getSound("GEO.CAT", w1->getRules()->getSound())->play();
-		_firedAtLeastOnce = true;
-	}
-}
-
-/**
- *	Each time a UFO will try to fire it's cannons
- *	a calculation is made. There's only 10% chance
- *	that it will actually fire.
- */
-void DogfightState::ufoFireWeapon()
-{
-	int fireCountdown = std::max(1, (_ufo->getRules()->getWeaponReload() - 2 * _game->getSavedGame()->getDifficultyCoefficient()));
-	{
-		int diff = _game->getSavedGame()->getDifficulty();
-		auto& custom = _game->getMod()->getUfoFiringRateCoefficients();
-		if (custom.size() > (size_t)diff)
+		bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
+		if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
 		{
-			fireCountdown = std::max(1, _ufo->getRules()->getWeaponReload() * custom[diff] / 100);
+			survived = false; // destroyed on real water
 		}
-	}
-	_ufo->setFireCountdown(RNG::generate(0, fireCountdown) + fireCountdown);
-
-	setStatus("STR_UFO_RETURN_FIRE");
-	CraftWeaponProjectile *p = new CraftWeaponProjectile();
-	p->setType(CWPT_PLASMA_BEAM);
-	p->setAccuracy(60);
-	p->setDamage(_ufo->getRules()->getWeaponPower());
-	p->setDirection(D_DOWN);
-	p->setHorizontalPosition(HP_CENTER);
-	p->setPosition(_currentDist - (_ufo->getRules()->getRadius() / 2));
-	_projectiles.push_back(p);
-	if (_ufoIsAttacking && _disableDisengage)
-	{
-		_ufo->increaseSoftlockShotCounter();
-	}
-
-	if (_ufo->getRules()->getFireSound() == -1)
-	{
-		_game->getMod()->getSound("GEO.CAT", Mod::UFO_FIRE)->play();
-	}
-	else
-	{
-		_game->getMod()->getSound("GEO.CAT", _ufo->getRules()->getFireSound())->play();
-	}
-}
-
-/**
- * Sets the craft to the minimum distance
- * required to fire a weapon.
- */
-void DogfightState::minimumDistance()
-{
-	int max = 0;
-	for (auto* cw : *_craft->getWeapons())
-	{
-		if (cw == 0)
-			continue;
-		if (cw->getRules()->getRange() > max && cw->getAmmo() > 0)
+		else if (fakeUnderwaterTexture)
 		{
-			max = cw->getRules()->getRange();
+			if (RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
+			{
+				setStatus("STR_UFO_SURVIVED_SPLASHDOWN");
+			}
+			else
+			{
+				survived = false; // destroyed on fake water
+				setStatus("STR_UFO_DESTROYED_BY_SPLASHDOWN");
+			}
 		}
-	}
-	if (max == 0)
-	{
-		_targetDist = STANDOFF_DIST;
-	}
-	else
-	{
-		_targetDist = max * 8;
-	}
-}
-
-/**
- * Sets the craft to the maximum distance
- * required to fire a weapon.
- */
-void DogfightState::maximumDistance()
-{
-	int min = 1000;
-	for (auto* cw : *_craft->getWeapons())
-	{
-		if (cw == 0)
-			continue;
-		if (cw->getRules()->getRange() < min && cw->getAmmo() > 0)
+		if (!survived)
 		{
-			min = cw->getRules()->getRange();
+			_ufo->setStatus(Ufo::DESTROYED);
+			_destroyUfo = true;
 		}
-	}
-	if (_ufoIsAttacking)
-	{
-		// If the UFO is actively hunting us, consider its weapon range too
-		if (_ufo->getRules()->getWeaponRange() > 0 && _ufo->getRules()->getWeaponRange() < min)
+		else
 		{
-			min = _ufo->getRules()->getWeaponRange();
+			_ufo->setSecondsRemaining(RNG::generate(24, 96)*3600);
+			_ufo->setAltitude("STR_GROUND");
+			if (_ufo->getCrashId() == 0)
+			{
+				_ufo->setCrashId(_game->getSavedGame()->getId("STR_CRASH_SITE"));
+				if (_ufo->isHunterKiller())
+				{
+					// stop being a hunter-killer
+					_ufo->resetOriginalDestination(_craft);
+					_ufo->setHunterKiller(false);
+				}
+			}
 		}
 	}
-	if (min == 1000)
-	{
-		_targetDist = STANDOFF_DIST;
-	}
-	else
-	{
-		_targetDist = min * 8;
-	}
-}
-
-/**
- * Sets the craft to the distance relevant for aggressive attack.
- */
-void DogfightState::aggressiveDistance()
-{
-	maximumDistance();
-	if (_targetDist > AGGRESSIVE_DIST)
+	if (_ufo->getShotDownByCraftId() != _craft->getUniqueId())
 	{
-		_targetDist = AGGRESSIVE_DIST;
+		_ufo->setHitFrame(3);
 	}
+	return !survived;
 }
 
 /**
@@ -1968,7 +1366,7 @@ void DogfightState::aggressiveDistance()
 void DogfightState::setStatus(const std::string &status)
 {
 	_txtStatus->setText(tr(status));
-	_timeout = 50;
+	_sim->setStatus();
 }
 
 /**
@@ -1977,22 +1375,22 @@ void DogfightState::setStatus(const std::string &status)
  */
 void DogfightState::btnMinimizeClick(Action *)
 {
-	if (_craftIsDefenseless)
+	if (_sim->isCraftDefenseless())
 	{
-		_selfDestructPressed = !_selfDestructPressed;
-		if (_selfDestructPressed)
+		_sim->setSelfDestruct(!_sim->getSelfDestruct());
+		if (_sim->getSelfDestruct())
 			setStatus("STR_SELF_DESTRUCT_ACTIVATED");
 		else
 			setStatus("STR_SELF_DESTRUCT_CANCELLED");
 		int offset = _game->getMod()->getInterface("dogfight")->getElement("minimizeButtonDummy")->TFTDMode ? 1 : 0;
-		int color = _selfDestructPressed ? DAMAGE_MIN : DAMAGE_MAX;
+		int color = _sim->getSelfDestruct() ? DAMAGE_MIN : DAMAGE_MAX;
 		_btnMinimize->drawRect(1 + offset, 1, _btnMinimize->getWidth() - 2 - offset, _btnMinimize->getHeight() - 2, _colors[color]);
 		return;
 	}
 
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
+	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_sim->isUfoBreakingOff())
 	{
-		if (_currentDist >= STANDOFF_DIST)
+		if (_sim->getDistance() >= STANDOFF_DIST)
 		{
 			setMinimized(true);
 			_ufo->setShieldRechargeHandle(0);
@@ -2010,11 +1408,10 @@ void DogfightState::btnMinimizeClick(Action *)
  */
 void DogfightState::btnStandoffPress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
+	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_sim->isUfoBreakingOff())
 	{
-		_end = false;
 		setStatus("STR_STANDOFF");
-		_targetDist = STANDOFF_DIST;
+		_sim->setMode(DSM_STANDOFF);
 	}
 }
 
@@ -2037,37 +1434,17 @@ void DogfightState::btnStandoffSimulateLeftPress(Action *action)
  */
 void DogfightState::btnCautiousPress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
+	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_sim->isUfoBreakingOff())
 	{
-		_end = false;
 		if (!_ufoIsAttacking)
 		{
 			setStatus("STR_CAUTIOUS_ATTACK");
-			for (int i = 0; i < _weaponNum; ++i)
-			{
-				CraftWeapon* w = _craft->getWeapons()->at(i);
-				if (w != 0)
-				{
-					_weaponFireInterval[i] = w->getRules()->getCautiousReload();
-				}
-			}
-			minimumDistance();
 		}
 		else
 		{
 			setStatus("STR_EVASIVE_MANEUVERS");
-			for (int i = 0; i < _weaponNum; ++i)
-			{
-				CraftWeapon* w = _craft->getWeapons()->at(i);
-				if (w != 0)
-				{
-					// double the craft's reload time to balance halving the HK's chance to hit
-					_weaponFireInterval[i] = w->getRules()->getAggressiveReload() * 2;
-				}
-			}
-			// same distance as aggressive (by design)
-			aggressiveDistance();
 		}
+		_sim->setMode(DSM_CAUTIOUS);
 	}
 }
 
@@ -2090,19 +1467,10 @@ void DogfightState::btnCautiousSimulateLeftPress(Action *action)
  */
 void DogfightState::btnStandardPress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
+	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_sim->isUfoBreakingOff())
 	{
-		_end = false;
 		setStatus("STR_STANDARD_ATTACK");
-		for (int i = 0; i < _weaponNum; ++i)
-		{
-			CraftWeapon* w = _craft->getWeapons()->at(i);
-			if (w != 0)
-			{
-				_weaponFireInterval[i] = w->getRules()->getStandardReload();
-			}
-		}
-		maximumDistance();
+		_sim->setMode(DSM_STANDARD);
 	}
 }
 
@@ -2125,19 +1493,10 @@ void DogfightState::btnStandardSimulateLeftPress(Action *action)
  */
 void DogfightState::btnAggressivePress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
+	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_sim->isUfoBreakingOff())
 	{
-		_end = false;
 		setStatus("STR_AGGRESSIVE_ATTACK");
-		for (int i = 0; i < _weaponNum; ++i)
-		{
-			CraftWeapon* w = _craft->getWeapons()->at(i);
-			if (w != 0)
-			{
-				_weaponFireInterval[i] = w->getRules()->getAggressiveReload();
-			}
-		}
-		aggressiveDistance();
+		_sim->setMode(DSM_AGGRESSIVE);
 	}
 }
 
@@ -2160,11 +1519,10 @@ void DogfightState::btnAggressiveSimulateLeftPress(Action *action)
  */
 void DogfightState::btnDisengagePress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
+	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_sim->isUfoBreakingOff())
 	{
-		_end = true;
 		setStatus("STR_DISENGAGING");
-		_targetDist = 800;
+		_sim->setMode(DSM_DISENGAGE);
 	}
 }
 
@@ -2216,7 +1574,7 @@ void DogfightState::previewClick(Action *)
 	_btnAggressive->setVisible(!_disableAggressive);
 	_btnDisengage->setVisible(!_disableDisengage);
 	_btnUfo->setVisible(true);
-	_btnMinimize->setVisible(!_ufoIsAttacking || _craftIsDefenseless);
+	_btnMinimize->setVisible(!_ufoIsAttacking || _sim->isCraftDefenseless());
 	for (int i = 0; i < _weaponNum; ++i)
 	{
 		_weapon[i]->setVisible(true);
@@ -2235,7 +1593,7 @@ void DogfightState::drawUfo()
 		return;
 	}
 	int currentUfoXposition =  _battle->getWidth() / 2 - 6;
-	int currentUfoYposition = _battle->getHeight() - (_currentDist / 8) - 6;
+	int currentUfoYposition = _battle->getHeight() - (_sim->getDistance() / 8) - 6;
 	for (int y = 0; y < 13; ++y)
 	{
 		for (int x = 0; x < 13; ++x)
@@ -2321,7 +1679,7 @@ void DogfightState::drawProjectile(const CraftWeaponProjectile* p)
 	else if (p->getGlobalType() == CWPGT_BEAM)
 	{
 		int yStart = _battle->getHeight() - 2;
-		int yEnd = _battle->getHeight() - (_currentDist / 8);
+		int yEnd = _battle->getHeight() - (_sim->getDistance() / 8);
 		Uint8 pixelOffset = p->getState();
 		for (int y = yStart; y > yEnd; --y)
 		{
@@ -2361,15 +1719,16 @@ void DogfightState::weaponClick(Action * a)
 	{
 		if (a->getSender() == _weapon[i])
 		{
-			_weaponEnabled[i] = !_weaponEnabled[i];
-			recolor(i, _weaponEnabled[i]);
+			bool enabled = !_sim->isWeaponEnabled(i);
+			_sim->setWeaponEnabled(i, enabled);
+			recolor(i, enabled);
 
 			if (Options::oxceRememberDisabledCraftWeapons)
 			{
 				CraftWeapon* w = _craft->getWeapons()->at(i);
 				if (w)
 				{
-					w->setDisabled(!_weaponEnabled[i]);
+					w->setDisabled(!enabled);
 				}
 			}
 			return;
@@ -2419,6 +1778,7 @@ void DogfightState::setMinimized(const bool minimized)
 {
 	// set these to the same as the incoming minimized state
 	_minimized = minimized;
+	_sim->setMinimized(minimized);
 	_btnMinimizedIcon->setVisible(minimized);
 	_txtInterceptionNumber->setVisible(minimized);
 
@@ -2477,6 +1837,7 @@ void DogfightState::btnMinimizedIconClick(Action *)
 void DogfightState::setInterceptionNumber(const int number)
 {
 	_interceptionNumber = number;
+	_sim->setInterceptionNumber(number);
 }
 
 /**
@@ -19,14 +19,13 @@
  */
 #include "../Engine/State.h"
 #include "../Mod/RuleCraft.h"
+#include "DogfightSimulator.h"
 #include <vector>
 #include <string>
 
 namespace OpenXcom
 {
 
-const int STANDOFF_DIST = 560;
-const int AGGRESSIVE_DIST = 64;
 enum ColorNames { CRAFT_MIN, CRAFT_MAX, RADAR_MIN, RADAR_MAX, DAMAGE_MIN, DAMAGE_MAX, BLOB_MIN, RANGE_METER, DISABLED_WEAPON, DISABLED_AMMO, DISABLED_RANGE, SHIELD_MIN, SHIELD_MAX };
 
 class ImageButton;
@@ -37,13 +36,13 @@ class Timer;
 class GeoscapeState;
 class Craft;
 class Ufo;
-class CraftWeaponProjectile;
 
 /**
  * Shows a dogfight (interception) between a
- * player craft and an UFO.
+ * player craft and an UFO. The combat itself
+ * is run by a DogfightSimulator.
  */
-class DogfightState : public State
+class DogfightState : public State, public DogfightListener
 {
 private:
 	GeoscapeState *_state;
@@ -56,27 +55,23 @@ private:
 	Text *_txtAmmo[RuleCraft::WeaponMax], *_txtDistance, *_txtStatus, *_txtInterceptionNumber;
 	Craft *_craft;
 	Ufo *_ufo;
-	bool _ufoIsAttacking, _missileCraft, _missileImpact;
+	DogfightSimulator *_sim;
+	bool _ufoIsAttacking, _missileCraft;
 	bool _disableDisengage, _disableStandoff, _disableCautious, _disableStandard, _disableAggressive;
-	bool _craftIsDefenseless, _selfDestructPressed;
-	int _timeout, _currentDist, _targetDist, _weaponFireInterval[RuleCraft::WeaponMax], _weaponFireCountdown[RuleCraft::WeaponMax];
-	bool _end, _endUfoHandled, _endCraftHandled, _ufoBreakingOff, _destroyUfo, _destroyCraft, _weaponEnabled[RuleCraft::WeaponMax];
+	bool _destroyUfo, _destroyCraft;
 	bool _minimized, _endDogfight, _animatingHit, _waitForPoly, _waitForAltitude;
-	std::vector<CraftWeaponProjectile*> _projectiles;
 	static const int _ufoBlobs[8][13][13];
 	static const int _projectileBlobs[4][6][3];
-	int _ufoSize, _ufoBlobSize, _craftHeight, _currentCraftDamageColor, _interceptionNumber;
+	int _ufoBlobSize, _craftHeight, _currentCraftDamageColor, _interceptionNumber;
 	size_t _interceptionsCount;
 	int _x, _y, _minimizedIconX, _minimizedIconY;
 	int _weaponNum;
-	int _pilotAccuracyBonus, _pilotDodgeBonus, _pilotApproachSpeedModifier, _craftAccelerationBonus;
 	bool _firedAtLeastOnce, _experienceAwarded;
 	bool _delayedRecolorDone;
 	// craft min/max, radar min/max, damage min/max, shield min/max
 	int _colors[13];
 	// Ends the dogfight.
 	void endDogfight();
-	bool _tractorLockedOn[RuleCraft::WeaponMax];
 
 public:
 	/// Creates the Dogfight state.
@@ -91,16 +86,10 @@ public:
 	void animate();
 	/// Moves the craft.
 	void update();
-	// Fires the weapons.
-	void fireWeapon(int i);
-	// Fires UFO weapon.
-	void ufoFireWeapon();
-	// Sets the craft to minimum distance.
-	void minimumDistance();
-	// Sets the craft to maximum distance.
-	void maximumDistance();
-	// Sets the craft to maximum distance or 8 km, whichever is smaller.
-	void aggressiveDistance();
+	/// Shows an event of the combat and applies it to the game.
+	void dogfightEvent(DogfightEvent event, int value, int extra) override;
+	/// Handles the UFO going down.
+	bool dogfightUfoDown(bool forcedDown) override;
 	/// Changes the status text.
 	void setStatus(const std::string &status);
 	/// Handler for clicking the Minimize button.
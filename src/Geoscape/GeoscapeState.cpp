@@ -639,6 +639,17 @@ void GeoscapeState::handle(Action *action)
 					ab->setDiscovered(true);
 				}
 			}
+			// "ctrl-b"
+			if (action->getDetails()->key.keysym.sym == SDLK_b)
+			{
+				std::ostringstream ss;
+				ss << "GLOBE REDRAW MS:";
+				for (double ms : _globe->benchmark(50))
+				{
+					ss << " " << std::fixed << std::setprecision(2) << ms;
+				}
+				_txtDebug->setText(ss.str());
+			}
 			// "ctrl-a"
 			if (action->getDetails()->key.keysym.sym == SDLK_a)
 			{
@@ -884,10 +895,22 @@ void GeoscapeState::timeAdvance()
 	}
 
 
+	// While nothing is flying, the 5-second steps are no-ops and can be
+	// fast-forwarded up to the next 10-minute trigger. Only the coarser
+	// triggers can change that, so the check is repeated after each of them.
+	bool quiet = Options::oxceGeoFastForwardQuietPeriods && timeSpan > 1 && isQuietPeriod();
 	for (int i = 0; i < timeSpan && !_pause; ++i)
 	{
 		TimeTrigger trigger;
 		trigger = _game->getSavedGame()->getTime()->advance();
+		if (trigger == TIME_5SEC)
+		{
+			if (!quiet)
+			{
+				time5Seconds();
+			}
+			continue;
+		}
 		switch (trigger)
 		{
 		case TIME_1MONTH:
@@ -908,6 +931,7 @@ void GeoscapeState::timeAdvance()
 		case TIME_5SEC:
 			time5Seconds();
 		}
+		quiet = quiet && isQuietPeriod();
 	}
 
 	_pause = !_dogfightsToBeStarted.empty() || _zoomInEffectTimer->isRunning() || _zoomOutEffectTimer->isRunning();
@@ -936,6 +960,37 @@ const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 	return &_activeCrafts;
 }
 
+/**
+ * Checks if a 5-second step would leave the game state untouched:
+ * no UFOs or craft in flight, no dogfights, no waypoints left to clean up
+ * and no craft shields recharging (which would consume random numbers).
+ * @return True if time5Seconds() can be safely skipped.
+ */
+bool GeoscapeState::isQuietPeriod() const
+{
+	SavedGame *save = _game->getSavedGame();
+	if (!_dogfights.empty() || !_dogfightsToBeStarted.empty() || _minimizedDogfights != 0 || !_popups.empty())
+		return false;
+	if (save->getBases()->empty() || save->getEnding() == END_LOSE || !save->getWaypoints()->empty())
+		return false;
+	for (const auto* ufo : *save->getUfos())
+	{
+		if (ufo->getStatus() != Ufo::IGNORE_ME)
+			return false;
+	}
+	for (const auto* xbase : *save->getBases())
+	{
+		for (const auto* xcraft : *xbase->getCrafts())
+		{
+			if (xcraft->isDestroyed() || xcraft->getDestination() != 0 || xcraft->getStatus() == "STR_OUT" || xcraft->hasTakeoffPending())
+				return false;
+			if (xcraft->getShield() < xcraft->getCraftStats().shieldCapacity && xcraft->getCraftStats().shieldRechargeInGeoscape != 0)
+				return false;
+		}
+	}
+	return true;
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game second, like craft movement.
@@ -1518,6 +1573,98 @@ bool DetectXCOMBase::operator()(const Ufo *ufo) const
 	return RNG::percent(_base.getDetectionChance());
 }
 
+/**
+ * Bases and active craft that can detect UFOs, gathered once per
+ * detection pass instead of once per UFO: the position terms of the
+ * distance formula and the list of finished radar facilities.
+ */
+class UfoDetectors
+{
+public:
+	/// Gathers the detectors.
+	UfoDetectors(const std::vector<Base*> &bases, const std::vector<Craft*> &crafts);
+	/// Tries to detect a UFO with every detector, in the same order as before.
+	UfoDetection detect(const Ufo *ufo, const SavedGame *save, bool alreadyTracked) const;
+private:
+	struct Detector
+	{
+		const Base *base;
+		const Craft *craft;
+		double lon, lat, cosLat, sinLat;
+		std::vector<const BaseFacility*> radars;
+	};
+	std::vector<Detector> _detectors;
+};
+
+/**
+ * Gathers the position terms and radar facilities of all detectors.
+ * @param bases All player bases.
+ * @param crafts Active craft.
+ */
+UfoDetectors::UfoDetectors(const std::vector<Base*> &bases, const std::vector<Craft*> &crafts)
+{
+	_detectors.resize(bases.size() + crafts.size());
+	size_t i = 0;
+	for (const auto* base : bases)
+	{
+		Detector &d = _detectors[i++];
+		d.base = base;
+		d.craft = nullptr;
+		d.lon = base->getLongitude();
+		d.lat = base->getLatitude();
+		base->getRadarFacilities(d.radars);
+	}
+	for (const auto* craft : crafts)
+	{
+		Detector &d = _detectors[i++];
+		d.base = nullptr;
+		d.craft = craft;
+		d.lon = craft->getLongitude();
+		d.lat = craft->getLatitude();
+	}
+	for (auto &d : _detectors)
+	{
+		d.cosLat = cos(d.lat);
+		d.sinLat = sin(d.lat);
+	}
+}
+
+/**
+ * Computes the distance from every detector to the UFO, using the same
+ * formula as Target::getDistance() so the results are bit for bit equal,
+ * and runs the detection rolls of bases then craft.
+ * @param ufo UFO to detect.
+ * @param save Current save.
+ * @param alreadyTracked Was ufo already detected.
+ * @return Combined detection flags.
+ */
+UfoDetection UfoDetectors::detect(const Ufo *ufo, const SavedGame *save, bool alreadyTracked) const
+{
+	const double lon = ufo->getLongitude();
+	const double lat = ufo->getLatitude();
+	const double cosLat = cos(lat);
+	const double sinLat = sin(lat);
+
+	int detected = DETECTION_NONE;
+	for (const auto &d : _detectors)
+	{
+		double distance = 0.0;
+		if (!(AreSame(lon, d.lon) && AreSame(lat, d.lat)))
+		{
+			distance = acos(d.cosLat * cosLat * cos(lon - d.lon) + d.sinLat * sinLat);
+		}
+		if (d.base)
+		{
+			detected |= d.base->detect(ufo, save, alreadyTracked, distance, d.radars);
+		}
+		else
+		{
+			detected |= d.craft->detect(ufo, save, alreadyTracked, distance);
+		}
+	}
+	return (UfoDetection)detected;
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game ten minutes, like fuel consumption.
@@ -1978,6 +2125,7 @@ void GeoscapeState::time30Minutes()
 
 	// can be updated by previous loop
 	auto* activeCrafts = updateActiveCrafts();
+	UfoDetectors detectors(*_game->getSavedGame()->getBases(), *activeCrafts);
 
 	// Handle UFO detection and give aliens points
 	for (auto* ufo : *_game->getSavedGame()->getUfos())
@@ -2015,7 +2163,7 @@ void GeoscapeState::time30Minutes()
 			}
 
 			// Detection ufo state
-			ufoDetection(ufo, activeCrafts);
+			ufoDetection(ufo, detectors);
 
 			break;
 		case Ufo::CRASHED:
@@ -2042,7 +2190,7 @@ void GeoscapeState::time30Minutes()
 		if (ge->isOver())
 		{
 			bool interrupted = false;
-			if (!ge->getRules().getInterruptResearch().empty())
+			if (ge->getRules().getInterruptResearch())
 			{
 				if (_game->getSavedGame()->isResearched(ge->getRules().getInterruptResearch(), false))
 				{
@@ -2070,31 +2218,17 @@ void GeoscapeState::time30Minutes()
 /**
  * Logic responsible for detecting ufo and its tracking.
  * @param ufo
+ * @param detectors Bases and craft gathered for this detection pass.
  */
-void GeoscapeState::ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCrafts)
+void GeoscapeState::ufoDetection(Ufo* ufo, const UfoDetectors &detectors)
 {
 	auto maskTest = [](UfoDetection value, UfoDetection mask)
 	{
 		return (value & mask) == mask;
 	};
-	auto maskBitOr = [](UfoDetection value, UfoDetection mask)
-	{
-		return (UfoDetection)(value | mask);
-	};
 
-	auto detected = DETECTION_NONE;
 	auto alreadyTracked = ufo->getDetected();
-	auto save = _game->getSavedGame();
-
-	for (auto* base : *_game->getSavedGame()->getBases())
-	{
-		detected = maskBitOr(detected, base->detect(ufo, save, alreadyTracked));
-	}
-
-	for (auto* craft : *activeCrafts)
-	{
-		detected = maskBitOr(detected, craft->detect(ufo, save, alreadyTracked));
-	}
+	auto detected = detectors.detect(ufo, _game->getSavedGame(), alreadyTracked);
 
 	if (!alreadyTracked)
 	{
@@ -2677,14 +2811,10 @@ void GeoscapeState::time1Day()
 	// check and interrupt alien missions if necessary (based on discovered research)
 	for (auto* am : saveGame->getAlienMissions())
 	{
-		auto& researchName = am->getRules().getInterruptResearch();
-		if (!researchName.empty())
+		auto* research = am->getRules().getInterruptResearch();
+		if (research && saveGame->isResearched(research, false)) // ignore debug mode
 		{
-			auto* research = mod->getResearch(researchName, true);
-			if (saveGame->isResearched(research, false)) // ignore debug mode
-			{
-				am->setInterrupted(true);
-			}
+			am->setInterrupted(true);
 		}
 	}
 
@@ -2693,10 +2823,9 @@ void GeoscapeState::time1Day()
 	while (abIt != saveGame->getAlienBases()->end())
 	{
 		AlienBase* ab = (*abIt);
-		auto& selfDestructCode = ab->getDeployment()->getBaseSelfDestructCode();
-		if (!selfDestructCode.empty())
+		auto* research = ab->getDeployment()->getBaseSelfDestructCode();
+		if (research)
 		{
-			auto* research = mod->getResearch(selfDestructCode, true);
 			if (saveGame->isResearched(research, false)) // ignore debug mode
 			{
 				saveGame->clearLinksForAlienBase(ab, _game->getMod());
@@ -3603,7 +3732,7 @@ void GeoscapeState::determineAlienMissions()
 			{
 				// level two condition check: make sure we meet any research requirements, if any.
 				bool triggerHappy = true;
-				for (auto& trigger : arcScript->getResearchTriggers())
+				for (auto& trigger : arcScript->getResearchTriggerRules())
 				{
 					triggerHappy = (save->isResearched(trigger.first) == trigger.second);
 					if (!triggerHappy)
@@ -3777,7 +3906,7 @@ void GeoscapeState::determineAlienMissions()
 		{
 			// level two condition check: make sure we meet any research requirements, if any.
 			bool triggerHappy = true;
-			for (auto& triggerResearch : command->getResearchTriggers())
+			for (auto& triggerResearch : command->getResearchTriggerRules())
 			{
 				triggerHappy = (save->isResearched(triggerResearch.first) == triggerResearch.second);
 				if (!triggerHappy)
@@ -3943,7 +4072,7 @@ void GeoscapeState::determineAlienMissions()
 			{
 				// level two condition check: make sure we meet any research requirements, if any.
 				bool triggerHappy = true;
-				for (auto& trigger : eventScript->getResearchTriggers())
+				for (auto& trigger : eventScript->getResearchTriggerRules())
 				{
 					triggerHappy = (save->isResearched(trigger.first) == trigger.second);
 					if (!triggerHappy)
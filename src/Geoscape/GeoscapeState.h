@@ -36,6 +36,7 @@ class Ufo;
 class MissionSite;
 class Base;
 class RuleMissionScript;
+class UfoDetectors;
 
 /**
  * Geoscape screen which shows an overview of
@@ -65,6 +66,8 @@ private:
 
 	/// Update list of active crafts.
 	const std::vector<Craft*>* updateActiveCrafts();
+	/// Checks if the 5-second logic has nothing to do.
+	bool isQuietPeriod() const;
 
 	void cbxRegionChange(Action *action);
 	void cbxZoneChange(Action *action);
@@ -95,7 +98,7 @@ public:
 	void baseHunting();
 	/// Trigger whenever 30 minutes pass.
 	void time30Minutes();
-	void ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCrafts);
+	void ufoDetection(Ufo* ufo, const UfoDetectors &detectors);
 	/// Trigger whenever 1 hour passes.
 	void time1Hour();
 	/// Trigger whenever 1 day passes.
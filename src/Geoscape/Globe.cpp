@@ -53,6 +53,8 @@
 #include "../Mod/Texture.h"
 #include "../Interface/Cursor.h"
 #include "../Engine/Screen.h"
+#include "../Engine/Logger.h"
+#include <chrono>
 
 namespace OpenXcom
 {
@@ -309,6 +311,40 @@ struct CreateShadow
 	}
 };
 
+struct CalculateShadow
+{
+	static const Uint8 NoEarth = 0xFF;
+
+	static inline void func(Uint8& shadow, const Cord& earth, const Cord& sun, const Sint16& noise)
+	{
+		shadow = earth.z ? CreateShadow::getShadowValue(earth, sun, noise) : NoEarth;
+	}
+};
+
+struct ApplyShadow
+{
+	static inline void func(Uint8& dest, const Uint8& shadow)
+	{
+		if (dest && shadow != CalculateShadow::NoEarth)
+		{
+			//this pixel is ocean
+			if (CreateShadow::isOcean(dest))
+			{
+				dest = CreateShadow::getOceanShadow(shadow);
+			}
+			//this pixel is land
+			else
+			{
+				dest = CreateShadow::getLandShadow(dest, shadow);
+			}
+		}
+		else
+		{
+			dest = 0;
+		}
+	}
+};
+
 struct CreateShadowWithoutCache
 {
 	static inline void func(Uint8& dest, const helper::Offset& offset, const Cord& sun, const Sint16& noise, const int& radius)
@@ -331,7 +367,7 @@ struct CreateShadowWithoutCache
  * @param x X position in pixels.
  * @param y Y position in pixels.
  */
-Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y) : InteractiveSurface(width, height, x, y), _cenX(cenX), _cenY(cenY), _rotLon(0.0), _rotLat(0.0), _hoverLon(0.0), _hoverLat(0.0), _craftLon(0.0), _craftLat(0.0), _craftRange(0.0), _game(game), _hover(false), _craft(false), _blink(-1),
+Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y) : InteractiveSurface(width, height, x, y), _cenX(cenX), _cenY(cenY), _rotLon(0.0), _rotLat(0.0), _hoverLon(0.0), _hoverLat(0.0), _craftLon(0.0), _craftLat(0.0), _craftRange(0.0), _game(game), _hover(false), _craft(false), _blink(-1), _shadowCacheZoom(0),
 																					_isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _lonBeforeMouseScrolling(0.0), _latBeforeMouseScrolling(0.0), _mouseScrollingStartTime(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false)
 {
 	_rules = game->getMod()->getGlobe();
@@ -358,6 +394,7 @@ Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y
 	setupRadii(width, height);
 	setZoom(_zoom);
 
+	buildPolygonPoints();
 	cachePolygons();
 }
 
@@ -373,11 +410,6 @@ Globe::~Globe()
 	delete _texture;
 	delete _radars;
 	delete _clipper;
-
-	for (auto* polygon : _cacheLand)
-	{
-		delete polygon;
-	}
 }
 
 /**
@@ -452,14 +484,23 @@ bool Globe::pointBack(double lon, double lat) const
 	return c < 0.0;
 }
 
+/**
+ * Finds the land polygon containing a point.
+ * Only the polygons registered in the point's index cell are tested.
+ * @param lon Longitude of the point.
+ * @param lat Latitude of the point.
+ * @return First polygon (in rule order) containing the point, or null.
+ */
 Polygon* Globe::getPolygonFromLonLat(double lon, double lat) const
 {
 	const double zDiscard=0.75f;
 	double coslat = cos(lat);
 	double sinlat = sin(lat);
 
-	for (auto* polygon : *_rules->getPolygons())
+	const size_t cell = getPolygonIndexCell(lon, lat);
+	for (size_t i = _polygonIndexStart[cell]; i < _polygonIndexStart[cell + 1]; ++i)
 	{
+		Polygon *polygon = _polygons[_polygonIndex[i]];
 		double x, y, z, x2, y2;
 		double clat, clon;
 		z = 0;
@@ -496,6 +537,107 @@ Polygon* Globe::getPolygonFromLonLat(double lon, double lat) const
 	return NULL;
 }
 
+/**
+ * Gets the cell of the polygon index that contains a point.
+ * Cells are a regular lon/lat grid.
+ * @param lon Longitude of the point.
+ * @param lat Latitude of the point.
+ * @return Cell number.
+ */
+size_t Globe::getPolygonIndexCell(double lon, double lat)
+{
+	int lonCell = (int)floor(lon / (2 * M_PI) * POLYGON_INDEX_LON_CELLS) % POLYGON_INDEX_LON_CELLS;
+	if (lonCell < 0)
+	{
+		lonCell += POLYGON_INDEX_LON_CELLS;
+	}
+	int latCell = Clamp((int)floor((lat + M_PI_2) / M_PI * POLYGON_INDEX_LAT_CELLS), 0, POLYGON_INDEX_LAT_CELLS - 1);
+	return (size_t)latCell * POLYGON_INDEX_LON_CELLS + lonCell;
+}
+
+/**
+ * Registers every polygon in all the index cells it can cover.
+ * A point can only be inside a polygon (as tested by getPolygonFromLonLat)
+ * if it lies in the spherical convex hull of its points, so each polygon
+ * is bounded by a cap around its mean direction and the cap's lon/lat
+ * bounding box decides the cells.
+ */
+void Globe::buildPolygonIndex()
+{
+	const double margin = 1e-6;
+	const double lonCellSize = 2 * M_PI / POLYGON_INDEX_LON_CELLS;
+	const double latCellSize = M_PI / POLYGON_INDEX_LAT_CELLS;
+	std::vector<std::vector<size_t> > cells(POLYGON_INDEX_LON_CELLS * POLYGON_INDEX_LAT_CELLS);
+
+	for (size_t p = 0; p < _polygons.size(); ++p)
+	{
+		const size_t first = _polygonFirstPoint[p], last = _polygonFirstPoint[p + 1];
+		if (first == last)
+		{
+			continue;
+		}
+		Cord center;
+		for (size_t j = first; j < last; ++j)
+		{
+			center += Cord(_pointX[j], _pointY[j], _pointZ[j]);
+		}
+		double norm = center.norm();
+		double capRadius = M_PI;
+		if (norm > margin)
+		{
+			center *= 1. / norm;
+			capRadius = 0;
+			for (size_t j = first; j < last; ++j)
+			{
+				double dot = center.x * _pointX[j] + center.y * _pointY[j] + center.z * _pointZ[j];
+				capRadius = std::max(capRadius, acos(Clamp(dot, -1.0, 1.0)));
+			}
+			capRadius += margin;
+		}
+
+		int latFirst = 0, latLast = POLYGON_INDEX_LAT_CELLS - 1;
+		int lonFirst = 0, lonLast = POLYGON_INDEX_LON_CELLS - 1;
+		if (capRadius < M_PI_2)
+		{
+			CordPolar polar = CordPolar(center);
+			double latMin = polar.lat - capRadius;
+			double latMax = polar.lat + capRadius;
+			latFirst = Clamp((int)floor((latMin + M_PI_2) / latCellSize), 0, POLYGON_INDEX_LAT_CELLS - 1);
+			latLast = Clamp((int)floor((latMax + M_PI_2) / latCellSize), 0, POLYGON_INDEX_LAT_CELLS - 1);
+			if (latMin > -M_PI_2 && latMax < M_PI_2)
+			{
+				// cap doesn't reach a pole, so it has a limited longitude span
+				double halfWidth = asin(std::min(1.0, sin(capRadius) / cos(polar.lat)));
+				lonFirst = (int)floor((polar.lon - halfWidth) / lonCellSize);
+				lonLast = (int)floor((polar.lon + halfWidth) / lonCellSize);
+				if (lonLast - lonFirst >= POLYGON_INDEX_LON_CELLS)
+				{
+					lonFirst = 0;
+					lonLast = POLYGON_INDEX_LON_CELLS - 1;
+				}
+			}
+		}
+
+		for (int latCell = latFirst; latCell <= latLast; ++latCell)
+		{
+			for (int lonCell = lonFirst; lonCell <= lonLast; ++lonCell)
+			{
+				int wrapped = ((lonCell % POLYGON_INDEX_LON_CELLS) + POLYGON_INDEX_LON_CELLS) % POLYGON_INDEX_LON_CELLS;
+				cells[(size_t)latCell * POLYGON_INDEX_LON_CELLS + wrapped].push_back(p);
+			}
+		}
+	}
+
+	_polygonIndexStart.clear();
+	_polygonIndex.clear();
+	for (const auto& cell : cells)
+	{
+		_polygonIndexStart.push_back(_polygonIndex.size());
+		_polygonIndex.insert(_polygonIndex.end(), cell.begin(), cell.end());
+	}
+	_polygonIndexStart.push_back(_polygonIndex.size());
+}
+
 /**
  * Sets a leftwards rotation speed and starts the timer.
  */
@@ -785,13 +927,31 @@ bool Globe::targetNear(Target* target, int x, int y) const
 std::vector<Target*> Globe::getTargets(int x, int y, bool craft, Craft *currentCraft) const
 {
 	std::vector<Target*> v;
+
+	// targets too far in latitude can't be near the point, this check needs no trigonometry
+	double pointLat = 0.0;
+	double maxLatDiff = 2 * M_PI;
+	const double dx = x - _cenX, dy = y - _cenY;
+	if (dx * dx + dy * dy < _radius * _radius * 0.99)
+	{
+		double pointLon;
+		cartToPolar(x, y, &pointLon, &pointLat);
+		// screen distance (with rounding) bounds the distance on the sphere, even near the edge
+		const double screenDist = (sqrt((double)NEAR_RADIUS) + 2) / _radius;
+		const double chord = sqrt(screenDist * screenDist + 2 * screenDist);
+		maxLatDiff = 2 * asin(std::min(1.0, chord / 2));
+	}
+	auto isNear = [&](Target* target)
+	{
+		return std::abs(target->getLatitude() - pointLat) <= maxLatDiff && targetNear(target, x, y);
+	};
 	{
 		for (auto* xbase : *_game->getSavedGame()->getBases())
 		{
 			if (xbase->getLongitude() == 0.0 && xbase->getLatitude() == 0.0)
 				continue;
 
-			if (targetNear(xbase, x, y))
+			if (isNear(xbase))
 			{
 				v.push_back(xbase);
 			}
@@ -803,7 +963,7 @@ std::vector<Target*> Globe::getTargets(int x, int y, bool craft, Craft *currentC
 				if (xcraft->getLongitude() == xbase->getLongitude() && xcraft->getLatitude() == xbase->getLatitude() && xcraft->getDestination() == 0)
 					continue;
 
-				if (targetNear(xcraft, x, y))
+				if (isNear(xcraft))
 				{
 					v.push_back(xcraft);
 				}
@@ -815,21 +975,21 @@ std::vector<Target*> Globe::getTargets(int x, int y, bool craft, Craft *currentC
 		if (!ufo->getDetected() || ufo->getStatus() == Ufo::IGNORE_ME)
 			continue;
 
-		if (targetNear(ufo, x, y))
+		if (isNear(ufo))
 		{
 			v.push_back(ufo);
 		}
 	}
 	for (auto* wp : *_game->getSavedGame()->getWaypoints())
 	{
-		if (targetNear(wp, x, y))
+		if (isNear(wp))
 		{
 			v.push_back(wp);
 		}
 	}
 	for (auto* site : *_game->getSavedGame()->getMissionSites())
 	{
-		if (targetNear(site, x, y))
+		if (isNear(site))
 		{
 			v.push_back(site);
 		}
@@ -840,7 +1000,7 @@ std::vector<Target*> Globe::getTargets(int x, int y, bool craft, Craft *currentC
 		{
 			continue;
 		}
-		if (targetNear(ab, x, y))
+		if (isNear(ab))
 		{
 			v.push_back(ab);
 		}
@@ -849,60 +1009,115 @@ std::vector<Target*> Globe::getTargets(int x, int y, bool craft, Craft *currentC
 }
 
 /**
- * Takes care of pre-calculating all the polygons currently visible
- * on the globe and caching them so they only need to be recalculated
- * when the globe is actually moved.
+ * Converts the points of all the land polygons into unit vectors,
+ * so they can be projected without any trigonometry on every redraw.
  */
-void Globe::cachePolygons()
+void Globe::buildPolygonPoints()
 {
-	cache(_rules->getPolygons(), &_cacheLand);
+	_polygons.assign(_rules->getPolygons()->begin(), _rules->getPolygons()->end());
+	_polygonFirstPoint.clear();
+	_pointX.clear();
+	_pointY.clear();
+	_pointZ.clear();
+	for (auto* polygon : _polygons)
+	{
+		_polygonFirstPoint.push_back(_pointX.size());
+		for (int j = 0; j < polygon->getPoints(); ++j)
+		{
+			Cord point = Cord(CordPolar(polygon->getLongitude(j), polygon->getLatitude(j)));
+			_pointX.push_back(point.x);
+			_pointY.push_back(point.y);
+			_pointZ.push_back(point.z);
+		}
+	}
+	_polygonFirstPoint.push_back(_pointX.size());
+	_screenX.resize(_pointX.size());
+	_screenY.resize(_pointX.size());
+	_pointDepth.resize(_pointX.size());
+
+	buildPolygonIndex();
 }
 
 /**
- * Caches a set of polygons.
- * @param polygons Pointer to list of polygons.
- * @param cache Pointer to cache.
+ * Takes care of pre-calculating all the polygons currently visible
+ * on the globe and caching them so they only need to be recalculated
+ * when the globe is actually moved.
+ * All points are projected in one pass over flat arrays
+ * (which the compiler can vectorize), then polygons facing
+ * away from the viewer are culled.
  */
-void Globe::cache(std::list<Polygon*> *polygons, std::list<Polygon*> *cache)
+void Globe::cachePolygons()
 {
-	// Clear existing cache
-	for (auto* polygon : *cache)
+	const double cosLon = cos(_cenLon);
+	const double sinLon = sin(_cenLon);
+	const double cosLat = cos(_cenLat);
+	const double sinLat = sin(_cenLat);
+	const double radius = _radius;
+	const size_t size = _pointX.size();
+	const double *px = _pointX.data(), *py = _pointY.data(), *pz = _pointZ.data();
+	double *depth = _pointDepth.data();
+	Sint16 *sx = _screenX.data(), *sy = _screenY.data();
+
+	// Orthographic projection, same as polarToCart
+	for (size_t i = 0; i < size; ++i)
 	{
-		delete polygon;
+		const double front = pz[i] * cosLon + px[i] * sinLon;
+		const double side = px[i] * cosLon - pz[i] * sinLon;
+		depth[i] = cosLat * front + sinLat * py[i];
+		sx[i] = _cenX + (Sint16)floor(radius * side);
+		sy[i] = _cenY + (Sint16)floor(radius * (cosLat * py[i] - sinLat * front));
 	}
-	cache->clear();
 
-	// Pre-calculate values to cache
-	for (auto* polygon : *polygons)
+	_cacheLand.clear();
+	for (size_t p = 0; p < _polygons.size(); ++p)
 	{
 		// Is quad on the back face?
 		double closest = 0.0;
-		double z;
 		double furthest = 0.0;
-		for (int j = 0; j < polygon->getPoints(); ++j)
+		for (size_t j = _polygonFirstPoint[p]; j < _polygonFirstPoint[p + 1]; ++j)
 		{
-			z = cos(_cenLat) * cos(polygon->getLatitude(j)) * cos(polygon->getLongitude(j) - _cenLon) + sin(_cenLat) * sin(polygon->getLatitude(j));
-			if (z > closest)
-				closest = z;
-			else if (z < furthest)
-				furthest = z;
+			closest = std::max(closest, depth[j]);
+			furthest = std::min(furthest, depth[j]);
 		}
 		if (-furthest > closest)
 			continue;
 
-		Polygon* p = new Polygon(*polygon);
+		_cacheLand.push_back(p);
+	}
+}
 
-		// Convert coordinates
-		for (int j = 0; j < p->getPoints(); ++j)
+/**
+ * Redraws the whole globe a number of times at each zoom level,
+ * rotating it a bit every time so no cache can be reused,
+ * and reports the average time of a redraw.
+ * The view is restored afterwards.
+ * @param redraws Number of redraws per zoom level.
+ * @return Average redraw time in milliseconds for each zoom level.
+ */
+std::vector<double> Globe::benchmark(int redraws)
+{
+	const size_t oldZoom = _zoom;
+	const double oldLon = _cenLon;
+	std::vector<double> result;
+
+	for (size_t zoom = 0; zoom < _zoomRadius.size(); ++zoom)
+	{
+		setZoom(zoom);
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < redraws; ++i)
 		{
-			Sint16 x, y;
-			polarToCart(p->getLongitude(j), p->getLatitude(j), &x, &y);
-			p->setX(j, x);
-			p->setY(j, y);
+			_cenLon += ROTATE_LONGITUDE / (zoom + 1);
+			invalidate();
+			draw();
 		}
-
-		cache->push_back(p);
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		result.push_back(elapsed.count() / std::max(redraws, 1));
+		Log(LOG_INFO) << "Globe redraw at zoom " << zoom << ": " << result.back() << " ms (" << _cacheLand.size() << "/" << _polygons.size() << " polygons visible)";
 	}
+
+	_cenLon = oldLon;
+	setZoom(oldZoom);
+	return result;
 }
 
 /**
@@ -995,19 +1210,13 @@ void Globe::drawOcean()
  */
 void Globe::drawLand()
 {
-	Sint16 x[4], y[4];
-
-	for (auto* polygon : _cacheLand)
+	for (size_t p : _cacheLand)
 	{
-		// Convert coordinates
-		for (int j = 0; j < polygon->getPoints(); ++j)
-		{
-			x[j] = polygon->getX(j);
-			y[j] = polygon->getY(j);
-		}
+		const size_t first = _polygonFirstPoint[p];
+		const int points = _polygonFirstPoint[p + 1] - first;
 
 		// Apply textures according to zoom and shade
-		drawTexturedPolygon(x, y, polygon->getPoints(), _texture->getFrame(polygon->getTexture() + _zoomTexture), 0, 0);
+		drawTexturedPolygon(&_screenX[first], &_screenY[first], points, _texture->getFrame(_polygons[p]->getTexture() + _zoomTexture), 0, 0);
 	}
 }
 
@@ -1071,13 +1280,24 @@ void Globe::drawShadow()
 {
 	if (Options::globeSurfaceCache)
 	{
-		ShaderMove<Cord> earth = ShaderMove<Cord>(SurfaceRaw<Cord>(_earthData[_zoom], getWidth(), getHeight()));
-		ShaderRepeat<Sint16> noise = ShaderRepeat<Sint16>(SurfaceRaw<Sint16>(static_data.random_noise, static_data.random_surf_size, static_data.random_surf_size));
+		// shadow only depends on the sun, so redraws without time passing or rotation reuse it
+		const Cord sun = getSunDirection(_cenLon, _cenLat);
+		const size_t size = (size_t)getWidth() * getHeight();
+		if (_shadowCache.size() != size || _shadowCacheZoom != _zoom || _shadowCacheSun.x != sun.x || _shadowCacheSun.y != sun.y || _shadowCacheSun.z != sun.z)
+		{
+			ShaderMove<Cord> earth = ShaderMove<Cord>(SurfaceRaw<Cord>(_earthData[_zoom], getWidth(), getHeight()));
+			ShaderRepeat<Sint16> noise = ShaderRepeat<Sint16>(SurfaceRaw<Sint16>(static_data.random_noise, static_data.random_surf_size, static_data.random_surf_size));
+
+			earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
 
-		earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
+			_shadowCache.resize(size);
+			ShaderDraw<CalculateShadow>(ShaderSurface(SurfaceRaw<Uint8>(_shadowCache, getWidth(), getHeight())), earth, ShaderScalar(sun), noise);
+			_shadowCacheSun = sun;
+			_shadowCacheZoom = _zoom;
+		}
 
 		lock();
-		ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(getSunDirection(_cenLon, _cenLat)), noise);
+		ShaderDraw<ApplyShadow>(ShaderSurface(this), ShaderSurface(SurfaceRaw<const Uint8>(_shadowCache, getWidth(), getHeight())));
 		unlock();
 	}
 	else
@@ -2092,6 +2312,7 @@ void Globe::resize()
 	_cenX = width / 2;
 	_cenY = height / 2;
 	setupRadii(width, height);
+	_shadowCache.clear();
 	invalidate();
 }
 
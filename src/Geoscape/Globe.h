@@ -52,6 +52,8 @@ private:
 	static const int CITY_MARKER = 8;
 	static const double ROTATE_LONGITUDE;
 	static const double ROTATE_LATITUDE;
+	static const int POLYGON_INDEX_LON_CELLS = 180;
+	static const int POLYGON_INDEX_LAT_CELLS = 90;
 
 	RuleGlobe *_rules;
 	Sint16 _cenX, _cenY;
@@ -64,7 +66,22 @@ private:
 	bool _hover, _craft;
 	int _blink;
 	Timer *_blinkTimer, *_rotTimer;
-	std::list<Polygon*> _cacheLand;
+	///unit vectors of all polygon points, built once from the rules
+	std::vector<double> _pointX, _pointY, _pointZ;
+	///screen position of all polygon points for the current view
+	std::vector<Sint16> _screenX, _screenY;
+	std::vector<double> _pointDepth;
+	///polygons and index of their first point, last entry closes the range
+	std::vector<Polygon*> _polygons;
+	std::vector<size_t> _polygonFirstPoint;
+	///polygons that can contain a point of each lon/lat cell, in rule order
+	std::vector<size_t> _polygonIndexStart, _polygonIndex;
+	///polygons facing the viewer
+	std::vector<size_t> _cacheLand;
+	///shadow of each pixel for the last sun direction
+	std::vector<Uint8> _shadowCache;
+	Cord _shadowCacheSun;
+	size_t _shadowCacheZoom;
 	FastLineClip *_clipper;
 	double _radius, _radiusStep;
 	///normal of each pixel in earth globe per zoom level
@@ -87,8 +104,12 @@ private:
 	Polygon* getPolygonFromLonLat(double lon, double lat) const;
 	/// Checks if a target is near a point.
 	bool targetNear(Target* target, int x, int y) const;
-	/// Caches a set of polygons.
-	void cache(std::list<Polygon*> *polygons, std::list<Polygon*> *cache);
+	/// Builds the unit vectors of all polygon points.
+	void buildPolygonPoints();
+	/// Builds the lon/lat cell index of the polygons.
+	void buildPolygonIndex();
+	/// Gets the polygon index cell of a point.
+	static size_t getPolygonIndexCell(double lon, double lat);
 	/// Get position of sun relative to given position in polar cords and date.
 	Cord getSunDirection(double lon, double lat) const;
 	/// Draw globe range circle.
@@ -163,6 +184,8 @@ public:
 	std::vector<Target*> getTargets(int x, int y, bool craft, Craft *currentCraft) const;
 	/// Caches visible globe polygons.
 	void cachePolygons();
+	/// Measures redraw time of the globe at each zoom level.
+	std::vector<double> benchmark(int redraws);
 	/// Sets the palette of the globe.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256) override;
 	/// Handles the timers.
@@ -34,7 +34,7 @@ namespace OpenXcom
  * @param x X position in pixels.
  * @param y Y position in pixels.
  */
-FpsCounter::FpsCounter(int width, int height, int x, int y) : Surface(width, height, x, y), _frames(0)
+FpsCounter::FpsCounter(int width, int height, int x, int y) : Surface(width, height, x, y), _frames(0), _lastStats(Text::getCacheStats())
 {
 	_visible = Options::fpsCounter;
 
@@ -42,7 +42,9 @@ FpsCounter::FpsCounter(int width, int height, int x, int y) : Surface(width, hei
 	_timer->onTimer((SurfaceHandler)&FpsCounter::update);
 	_timer->start();
 
-	_text = new NumberText(width, height, x, y);
+	_text = new NumberText(width, 5, x, y);
+	_layoutHits = new NumberText(width, 5, x, y + 6);
+	_rasterHits = new NumberText(width, 5, x, y + 12);
 }
 
 /**
@@ -51,6 +53,8 @@ FpsCounter::FpsCounter(int width, int height, int x, int y) : Surface(width, hei
 FpsCounter::~FpsCounter()
 {
 	delete _text;
+	delete _layoutHits;
+	delete _rasterHits;
 	delete _timer;
 }
 
@@ -64,6 +68,8 @@ void FpsCounter::setPalette(const SDL_Color *colors, int firstcolor, int ncolors
 {
 	Surface::setPalette(colors, firstcolor, ncolors);
 	_text->setPalette(colors, firstcolor, ncolors);
+	_layoutHits->setPalette(colors, firstcolor, ncolors);
+	_rasterHits->setPalette(colors, firstcolor, ncolors);
 }
 
 /**
@@ -73,6 +79,8 @@ void FpsCounter::setPalette(const SDL_Color *colors, int firstcolor, int ncolors
 void FpsCounter::setColor(Uint8 color)
 {
 	_text->setColor(color);
+	_layoutHits->setColor(color);
+	_rasterHits->setColor(color);
 }
 
 /**
@@ -97,13 +105,28 @@ void FpsCounter::think()
 }
 
 /**
- * Updates the amount of Frames per Second.
+ * Updates the amount of Frames per Second
+ * and the text cache hit rates (in %) of the last second.
  */
 void FpsCounter::update()
 {
 	int fps = (int)floor((double)_frames / _timer->getTime() * 1000);
 	_text->setValue(fps);
 	_frames = 0;
+
+	TextCacheStats stats = Text::getCacheStats();
+	auto hitRate = [](int hits, int misses)
+	{
+		return hits + misses > 0 ? 100 * hits / (hits + misses) : 100;
+	};
+	// the counts start over when the caches are cleared
+	if (stats.layoutHits < _lastStats.layoutHits || stats.layoutMisses < _lastStats.layoutMisses || stats.rasterHits < _lastStats.rasterHits || stats.rasterMisses < _lastStats.rasterMisses)
+	{
+		_lastStats = TextCacheStats();
+	}
+	_layoutHits->setValue(hitRate(stats.layoutHits - _lastStats.layoutHits, stats.layoutMisses - _lastStats.layoutMisses));
+	_rasterHits->setValue(hitRate(stats.rasterHits - _lastStats.rasterHits, stats.rasterMisses - _lastStats.rasterMisses));
+	_lastStats = stats;
 	_redraw = true;
 }
 
@@ -114,6 +137,11 @@ void FpsCounter::draw()
 {
 	Surface::draw();
 	_text->blit(this->getSurface());
+	if (Options::oxceTextCache)
+	{
+		_layoutHits->blit(this->getSurface());
+		_rasterHits->blit(this->getSurface());
+	}
 }
 
 void FpsCounter::addFrame()
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../Engine/Surface.h"
+#include "Text.h"
 
 namespace OpenXcom
 {
@@ -28,14 +29,16 @@ class Action;
 
 /**
  * Counts the amount of frames each second
- * and displays them in a NumberText surface.
+ * and displays them in a NumberText surface,
+ * along with the hit rates of the text caches.
  */
 class FpsCounter : public Surface
 {
 private:
-	NumberText *_text;
+	NumberText *_text, *_layoutHits, *_rasterHits;
 	Timer *_timer;
 	int _frames;
+	TextCacheStats _lastStats;
 public:
 	/// Creates a new FPS counter linked to a game.
 	FpsCounter(int width, int height, int x, int y);
@@ -17,6 +17,9 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Text.h"
+#include <cstring>
+#include <map>
+#include <tuple>
 #include "../fmath.h"
 #include "../Engine/Font.h"
 #include "../Engine/Options.h"
@@ -29,6 +32,60 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Everything the line breaks and line metrics of a text depend on.
+struct TextLayoutKey
+{
+	std::string text;
+	const Font *font, *small;
+	int width, wrapping;
+	bool wrap, indent, ignoreSeparators;
+
+	bool operator<(const TextLayoutKey &other) const
+	{
+		return std::tie(text, font, small, width, wrapping, wrap, indent, ignoreSeparators) <
+			std::tie(other.text, other.font, other.small, other.width, other.wrapping, other.wrap, other.indent, other.ignoreSeparators);
+	}
+};
+
+/// Processed text and line metrics of a text layout.
+struct TextLayout
+{
+	UString processedText;
+	std::vector<int> lineWidth, lineHeight;
+};
+
+/// Everything the rendered pixels of a text depend on.
+struct TextRasterKey
+{
+	UString processedText;
+	std::vector<int> lineWidth;
+	const Font *font, *small;
+	int width, height, color, color2, mul, mid, align, valign, direction;
+	bool debugUi;
+
+	bool operator<(const TextRasterKey &other) const
+	{
+		return std::tie(processedText, lineWidth, font, small, width, height, color, color2, mul, mid, align, valign, direction, debugUi) <
+			std::tie(other.processedText, other.lineWidth, other.font, other.small, other.width, other.height, other.color, other.color2, other.mul, other.mid, other.align, other.valign, other.direction, other.debugUi);
+	}
+};
+
+/// Cached layouts, shared by all the texts.
+std::map<TextLayoutKey, TextLayout> layoutCache;
+/// Cached rendered pixels, shared by all the texts.
+std::map<TextRasterKey, std::vector<Uint8> > rasterCache;
+TextCacheStats cacheStats = { };
+
+/// Start over when that many layouts are cached.
+const size_t MAX_CACHED_LAYOUTS = 8192;
+/// Start over when that many pixels are cached.
+const size_t MAX_CACHED_PIXELS = 8 * 1024 * 1024;
+
+}
+
 /**
  * Sets up a blank text with the specified size and position.
  * @param width Width in pixels.
@@ -316,6 +373,32 @@ void Text::processText()
 		return;
 	}
 
+	// Without wordwrap the layout doesn't depend on the width or the wrapping settings
+	TextLayoutKey key;
+	if (Options::oxceTextCache)
+	{
+		key.text = _text;
+		key.font = _font;
+		key.small = _small;
+		key.wrap = _wrap;
+		key.width = _wrap ? getWidth() : 0;
+		key.wrapping = _wrap ? (int)_lang->getTextWrapping() : 0;
+		key.indent = _wrap && _indent;
+		key.ignoreSeparators = _wrap && _ignoreSeparators;
+		auto cached = layoutCache.find(key);
+		if (cached != layoutCache.end())
+		{
+			cacheStats.layoutHits++;
+			_processedText = cached->second.processedText;
+			_lineWidth = cached->second.lineWidth;
+			_lineHeight = cached->second.lineHeight;
+			_scrollY = 0;
+			_redraw = true;
+			return;
+		}
+		cacheStats.layoutMisses++;
+	}
+
 	_processedText = Unicode::convUtf8ToUtf32(_text);
 	_lineWidth.clear();
 	_lineHeight.clear();
@@ -421,6 +504,18 @@ void Text::processText()
 		}
 	}
 
+	if (Options::oxceTextCache)
+	{
+		if (layoutCache.size() >= MAX_CACHED_LAYOUTS)
+		{
+			layoutCache.clear();
+		}
+		TextLayout &layout = layoutCache[key];
+		layout.processedText = _processedText;
+		layout.lineWidth = _lineWidth;
+		layout.lineHeight = _lineHeight;
+	}
+
 	_redraw = true;
 }
 
@@ -494,6 +589,38 @@ void Text::draw()
 		return;
 	}
 
+	// Texts that were already rendered the same way are copied over
+	bool cacheable = Options::oxceTextCache && !_scroll && _lang != 0;
+	TextRasterKey key;
+	if (cacheable)
+	{
+		key.processedText = _processedText;
+		key.lineWidth = _lineWidth;
+		key.font = _font;
+		key.small = _small;
+		key.width = getWidth();
+		key.height = getHeight();
+		key.color = _color;
+		key.color2 = _color2;
+		key.mul = _contrast ? 3 : 1;
+		key.mid = _invert ? 3 : 0;
+		key.align = _align;
+		key.valign = _valign;
+		key.direction = _lang->getTextDirection();
+		key.debugUi = Options::debugUi;
+		auto cached = rasterCache.find(key);
+		if (cached != rasterCache.end())
+		{
+			cacheStats.rasterHits++;
+			for (int row = 0; row < getHeight(); ++row)
+			{
+				memcpy(getRaw(0, row), &cached->second[row * getWidth()], getWidth());
+			}
+			return;
+		}
+		cacheStats.rasterMisses++;
+	}
+
 	// Show text borders for debugging
 	if (Options::debugUi)
 	{
@@ -589,6 +716,22 @@ void Text::draw()
 				x += dir * font->getCharSize(*c).w;
 		}
 	}
+
+	if (cacheable)
+	{
+		if (cacheStats.rasterBytes + getWidth() * getHeight() > MAX_CACHED_PIXELS)
+		{
+			rasterCache.clear();
+			cacheStats.rasterBytes = 0;
+		}
+		std::vector<Uint8> &pixels = rasterCache[key];
+		pixels.resize(getWidth() * getHeight());
+		for (int row = 0; row < getHeight(); ++row)
+		{
+			memcpy(&pixels[row * getWidth()], getRaw(0, row), getWidth());
+		}
+		cacheStats.rasterBytes += pixels.size();
+	}
 }
 
 /**
@@ -624,4 +767,25 @@ void Text::mousePress(Action* action, State* state)
 	}
 }
 
+/**
+ * Returns the hit counts of the layout and raster caches
+ * shared by all the texts, for the FPS counter.
+ * @return Cache statistics.
+ */
+TextCacheStats Text::getCacheStats()
+{
+	return cacheStats;
+}
+
+/**
+ * Clears the layout and raster caches shared by all the texts,
+ * eg. when the fonts they refer to are deleted.
+ */
+void Text::clearCache()
+{
+	layoutCache.clear();
+	rasterCache.clear();
+	cacheStats = TextCacheStats();
+}
+
 }
@@ -31,6 +31,15 @@ class Language;
 enum TextHAlign { ALIGN_LEFT, ALIGN_CENTER, ALIGN_RIGHT };
 enum TextVAlign { ALIGN_TOP, ALIGN_MIDDLE, ALIGN_BOTTOM };
 
+/**
+ * Hit counts of the shared text layout and raster caches.
+ */
+struct TextCacheStats
+{
+	int layoutHits, layoutMisses, rasterHits, rasterMisses;
+	size_t rasterBytes;
+};
+
 /**
  * Text string displayed on screen.
  * Takes the characters from a Font and puts them together on screen
@@ -106,6 +115,10 @@ public:
 	void setScrollable(bool scroll);
 	/// Special handling for mouse presses.
 	void mousePress(Action* action, State* state) override;
+	/// Gets the text cache statistics.
+	static TextCacheStats getCacheStats();
+	/// Clears the text caches.
+	static void clearCache();
 };
 
 }
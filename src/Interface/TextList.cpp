@@ -63,12 +63,9 @@ TextList::TextList(int width, int height, int x, int y) : InteractiveSurface(wid
  */
 TextList::~TextList()
 {
-	for (auto& vec : _texts)
+	for (auto* text : _pool)
 	{
-		for (auto* text : vec)
-		{
-			delete text;
-		}
+		delete text;
 	}
 	for (auto* ab : _arrowLeft)
 	{
@@ -155,7 +152,9 @@ void TextList::unpress(State *state)
  */
 void TextList::setCellColor(size_t row, size_t column, Uint8 color)
 {
-	_texts[row][column]->setColor(color);
+	TextListCell &cell = _cells[_texts[row].firstCell + column];
+	cell.color = color;
+	cell.color2 = color;
 	_redraw = true;
 }
 
@@ -166,9 +165,11 @@ void TextList::setCellColor(size_t row, size_t column, Uint8 color)
  */
 void TextList::setRowColor(size_t row, Uint8 color)
 {
-	for (auto* text : _texts[row])
+	for (size_t i = 0; i < _texts[row].cells; ++i)
 	{
-		text->setColor(color);
+		TextListCell &cell = _cells[_texts[row].firstCell + i];
+		cell.color = color;
+		cell.color2 = color;
 	}
 	_redraw = true;
 }
@@ -181,7 +182,7 @@ void TextList::setRowColor(size_t row, Uint8 color)
  */
 std::string TextList::getCellText(size_t row, size_t column) const
 {
-	return _texts[row][column]->getText();
+	return _cells[_texts[row].firstCell + column].text;
 }
 
 /**
@@ -192,7 +193,29 @@ std::string TextList::getCellText(size_t row, size_t column) const
  */
 void TextList::setCellText(size_t row, size_t column, const std::string &text)
 {
-	_texts[row][column]->setText(text);
+	// lay it out like the old text would have been, to see if it still fits the big font
+	TextListCell &cell = _cells[_texts[row].firstCell + column];
+	Text *txt = getPoolText(column);
+	if (txt->getWidth() != cell.width)
+	{
+		txt->setWidth(cell.width);
+	}
+	if (txt->getHeight() != _texts[row].height)
+	{
+		txt->setHeight(_texts[row].height);
+	}
+	txt->setWordWrap(cell.wrap, cell.wrap, cell.wrap && cell.ignoreSeparators);
+	if (cell.big)
+	{
+		txt->setBig();
+	}
+	else
+	{
+		txt->setSmall();
+	}
+	txt->setText(text);
+	cell.text = text;
+	cell.shrunk = cell.big && txt->getFont() == _small;
 	_redraw = true;
 }
 
@@ -203,7 +226,7 @@ void TextList::setCellText(size_t row, size_t column, const std::string &text)
  */
 int TextList::getColumnX(size_t column) const
 {
-	return getX() + _texts[0][column]->getX();
+	return getX() + _cells[_texts[0].firstCell + column].x;
 }
 
 /**
@@ -213,7 +236,7 @@ int TextList::getColumnX(size_t column) const
  */
 int TextList::getRowY(size_t row) const
 {
-	return getY() + _texts[row][0]->getY();
+	return getY() + _texts[row].y;
 }
 
 /**
@@ -223,7 +246,9 @@ int TextList::getRowY(size_t row) const
  */
 int TextList::getTextHeight(size_t row) const
 {
-	return _texts[row].front()->getTextHeight();
+	Text *txt = getPoolText(0);
+	setupText(txt, _texts[row], _cells[_texts[row].firstCell]);
+	return txt->getTextHeight();
 }
 
 /**
@@ -233,7 +258,9 @@ int TextList::getTextHeight(size_t row) const
  */
 int TextList::getNumTextLines(size_t row) const
 {
-	return _texts[row].front()->getNumLines();
+	Text *txt = getPoolText(0);
+	setupText(txt, _texts[row], _cells[_texts[row].firstCell]);
+	return txt->getNumLines();
 }
 
 /**
@@ -273,8 +300,8 @@ size_t TextList::getVisibleRows() const
 }
 
 /**
- * Adds a new row of text to the list, automatically creating
- * the required Text objects lined up where they need to be.
+ * Adds a new row of text to the list, automatically laying out
+ * the cells lined up where they need to be.
  * @param cols Number of columns.
  * @param ... Text for each cell in the new row.
  */
@@ -292,12 +319,14 @@ void TextList::addRow(int cols, ...)
 		ncols = 1;
 	}
 
-	std::vector<Text*> temp;
+	TextListRow row;
+	row.firstCell = _cells.size();
+	row.cells = ncols;
 	// Positions are relative to list surface.
 	int rowX = 0, rowY = 0, rows = 1, rowHeight = 0;
 	if (!_texts.empty())
 	{
-		rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
+		rowY = _texts.back().y + _texts.back().height + _font->getSpacing();
 	}
 
 	for (int i = 0; i < ncols; ++i)
@@ -312,16 +341,17 @@ void TextList::addRow(int cols, ...)
 		{
 			width = _columns[i];
 		}
-		Text* txt = new Text(width, _font->getHeight(), _margin + rowX, rowY);
-		txt->setPalette(this->getPalette());
-		txt->initText(_big, _small, _lang);
-		txt->setColor(_color);
-		txt->setSecondaryColor(_color2);
-		if (_align[i])
+		// Measure the text with the pooled one, it is only rendered when visible
+		Text* txt = getPoolText(i);
+		if (txt->getWidth() != width)
+		{
+			txt->setWidth(width);
+		}
+		if (txt->getHeight() != _font->getHeight())
 		{
-			txt->setAlign(_align[i]);
+			txt->setHeight(_font->getHeight());
 		}
-		txt->setHighContrast(_contrast);
+		txt->setWordWrap(false);
 		if (_font == _big)
 		{
 			txt->setBig();
@@ -332,6 +362,17 @@ void TextList::addRow(int cols, ...)
 		}
 		if (cols > 0)
 			txt->setText(va_arg(args, char*));
+		else
+			txt->setText("");
+		TextListCell cell;
+		cell.x = _margin + rowX;
+		cell.width = width;
+		cell.color = _color;
+		cell.color2 = _color2;
+		cell.align = _align[i];
+		cell.big = (_font == _big);
+		cell.wrap = false;
+		cell.ignoreSeparators = _ignoreSeparators;
 		// grab this before we enable word wrapping so we can use it to calculate
 		// the total row height below
 		int vmargin = _font->getHeight() - txt->getTextHeight();
@@ -339,6 +380,7 @@ void TextList::addRow(int cols, ...)
 		if (_wrap && txt->getTextWidth() > txt->getWidth())
 		{
 			txt->setWordWrap(true, true, _ignoreSeparators);
+			cell.wrap = true;
 			rows = std::max(rows, txt->getNumLines());
 		}
 		rowHeight = std::max(rowHeight, txt->getTextHeight() + vmargin);
@@ -364,7 +406,9 @@ void TextList::addRow(int cols, ...)
 			txt->setText(buf);
 		}
 
-		temp.push_back(txt);
+		cell.text = txt->getText();
+		cell.shrunk = cell.big && txt->getFont() == _small;
+		_cells.push_back(cell);
 		if (_condensed)
 		{
 			rowX += txt->getTextWidth();
@@ -376,12 +420,10 @@ void TextList::addRow(int cols, ...)
 	}
 
 	// ensure all elements in this row are the same height
-	for (int i = 0; i < cols; ++i)
-	{
-		temp[i]->setHeight(rowHeight);
-	}
+	row.y = rowY;
+	row.height = cols > 0 ? rowHeight : _font->getHeight();
 
-	_texts.push_back(temp);
+	_texts.push_back(row);
 	for (int i = 0; i < rows; ++i)
 	{
 		_rows.push_back(_texts.size() - 1);
@@ -432,6 +474,7 @@ void TextList::removeLastRow()
 {
 	if (!_texts.empty())
 	{
+		_cells.resize(_texts.back().firstCell);
 		_texts.pop_back();
 	}
 	if (!_rows.empty())
@@ -488,12 +531,9 @@ void TextList::setColumns(int cols, ...)
 void TextList::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
 {
 	Surface::setPalette(colors, firstcolor, ncolors);
-	for (auto& vec : _texts)
+	for (auto* text : _pool)
 	{
-		for (auto* text : vec)
-		{
-			text->setPalette(colors, firstcolor, ncolors);
-		}
+		text->setPalette(colors, firstcolor, ncolors);
 	}
 	for (auto* ab : _arrowLeft)
 	{
@@ -526,6 +566,12 @@ void TextList::initText(Font *big, Font *small, Language *lang)
 	_font = small;
 	_lang = lang;
 
+	for (auto* text : _pool)
+	{
+		delete text;
+	}
+	_pool.clear();
+
 	delete _selector;
 	_selector = new Surface(getWidth(), _font->getHeight() + _font->getSpacing(), getX(), getY());
 	_selector->setPalette(getPalette());
@@ -559,12 +605,10 @@ void TextList::setColor(Uint8 color)
 	_up->setColor(color);
 	_down->setColor(color);
 	_scrollbar->setColor(color);
-	for (auto& vec : _texts)
+	for (auto& cell : _cells)
 	{
-		for (auto* text : vec)
-		{
-			text->setColor(color);
-		}
+		cell.color = color;
+		cell.color2 = color;
 	}
 }
 
@@ -614,13 +658,7 @@ void TextList::setWordWrap(bool wrap)
 void TextList::setHighContrast(bool contrast)
 {
 	_contrast = contrast;
-	for (auto& vec : _texts)
-	{
-		for (auto* text : vec)
-		{
-			text->setHighContrast(contrast);
-		}
-	}
+	_redraw = true;
 	_scrollbar->setHighContrast(contrast);
 }
 
@@ -890,15 +928,8 @@ void TextList::onRightArrowRelease(ActionHandler handler)
  */
 void TextList::clearList()
 {
-	for (auto& vec : _texts)
-	{
-		for (auto* text : vec)
-		{
-			delete text;
-		}
-		vec.clear();
-	}
 	scrollUp(true, false);
+	_cells.clear();
 	_texts.clear();
 	_rows.clear();
 	_redraw = true;
@@ -989,6 +1020,61 @@ void TextList::updateVisible()
 	updateArrows();
 }
 
+/**
+ * Returns the Text used to measure and render the cells
+ * of a column, creating it the first time it's needed.
+ * @param column Column number.
+ * @return Pointer to the pooled text.
+ */
+Text *TextList::getPoolText(size_t column) const
+{
+	while (_pool.size() <= column)
+	{
+		Text *txt = new Text(1, _font->getHeight());
+		txt->setPalette(getPalette());
+		txt->initText(_big, _small, _lang);
+		_pool.push_back(txt);
+	}
+	return _pool[column];
+}
+
+/**
+ * Sets up a pooled Text with the contents and layout of a cell,
+ * so it renders the same as a Text made just for that cell.
+ * @param text Pointer to the pooled text.
+ * @param row Row of the cell.
+ * @param cell Cell to render.
+ */
+void TextList::setupText(Text *text, const TextListRow &row, const TextListCell &cell) const
+{
+	if (text->getWidth() != cell.width)
+	{
+		text->setWidth(cell.width);
+	}
+	if (text->getHeight() != row.height)
+	{
+		text->setHeight(row.height);
+	}
+	text->setX(cell.x);
+	text->setY(row.y);
+	text->setColor(cell.color);
+	text->setSecondaryColor(cell.color2);
+	text->setAlign(cell.align);
+	text->setHighContrast(_contrast);
+	text->setWordWrap(false);
+	// set the text with the small font so it doesn't get shrunk again
+	text->setSmall();
+	text->setText(cell.text);
+	if (cell.big && !cell.shrunk)
+	{
+		text->setBig();
+	}
+	if (cell.wrap)
+	{
+		text->setWordWrap(true, true, cell.ignoreSeparators);
+	}
+}
+
 /**
  * Changes whether the list can be scrolled.
  * @param scrolling True to allow scrolling, false otherwise.
@@ -1023,19 +1109,14 @@ void TextList::draw()
 		}
 		for (size_t i = _rows[_scroll]; i < _texts.size() && i < _rows[_scroll] + _visibleRows; ++i)
 		{
-			for (auto* text : _texts[i])
+			_texts[i].y = y;
+			for (size_t j = 0; j < _texts[i].cells; ++j)
 			{
-				text->setY(y);
+				Text *text = getPoolText(j);
+				setupText(text, _texts[i], _cells[_texts[i].firstCell + j]);
 				text->blit(this->getSurface());
 			}
-			if (!_texts[i].empty())
-			{
-				y += _texts[i].front()->getHeight() + _font->getSpacing();
-			}
-			else
-			{
-				y += _font->getHeight() + _font->getSpacing();
-			}
+			y += _texts[i].height + _font->getSpacing();
 		}
 	}
 }
@@ -1073,14 +1154,7 @@ void TextList::blit(SDL_Surface *surface)
 					_arrowRight[i]->blit(surface);
 				}
 
-				if (!_texts[i].empty())
-				{
-					y += _texts[i].front()->getHeight() + _font->getSpacing();
-				}
-				else
-				{
-					y += _font->getHeight() + _font->getSpacing();
-				}
+				y += _texts[i].height + _font->getSpacing();
 			}
 		}
 		_up->blit(surface);
@@ -1262,9 +1336,9 @@ void TextList::mouseOver(Action *action, State *state)
 		_selRow = std::max(0, (int)(_scroll + (int)floor(action->getRelativeYMouse() / (rowHeight * action->getYScale()))));
 		if (_selRow < _rows.size())
 		{
-			Text *selText = _texts[_rows[_selRow]].front();
-			int y = getY() + selText->getY();
-			int actualHeight = selText->getHeight() + _font->getSpacing(); //current line height
+			const TextListRow &selText = _texts[_rows[_selRow]];
+			int y = getY() + selText.y;
+			int actualHeight = selText.height + _font->getSpacing(); //current line height
 			if (y < getY() || y + actualHeight > getY() + getHeight())
 			{
 				actualHeight /= 2;
@@ -36,11 +36,30 @@ class ScrollBar;
  * Contains a set of Text's that are automatically lined up by
  * rows and columns, like a big table, making it easy to manage
  * them together.
+ * Only the cell contents are stored per row, the visible rows
+ * are rendered through a pool of one Text per column.
  */
 class TextList : public InteractiveSurface
 {
 private:
-	std::vector< std::vector<Text*> > _texts;
+	/// Contents and layout of one cell.
+	struct TextListCell
+	{
+		std::string text;
+		int x, width;
+		Uint8 color, color2;
+		TextHAlign align;
+		bool big, shrunk, wrap, ignoreSeparators;
+	};
+	/// Layout of one row, pointing to its cells.
+	struct TextListRow
+	{
+		size_t firstCell, cells;
+		int y, height;
+	};
+	std::vector<TextListCell> _cells;
+	std::vector<TextListRow> _texts;
+	mutable std::vector<Text*> _pool;
 	std::vector<size_t> _columns, _rows;
 	Font *_big, *_small, *_font;
 	Language *_lang;
@@ -65,6 +84,10 @@ private:
 	void updateArrows();
 	/// Updates the visible rows.
 	void updateVisible();
+	/// Gets the pooled Text used to render a column.
+	Text *getPoolText(size_t column) const;
+	/// Sets up a pooled Text to render a cell.
+	void setupText(Text *text, const TextListRow &row, const TextListCell &cell) const;
 public:
 	/// Creates a text list with the specified size and position.
 	TextList(int width, int height, int x = 0, int y = 0);
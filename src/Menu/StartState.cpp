@@ -35,6 +35,9 @@
 #include "../Interface/Text.h"
 #include "MainMenuState.h"
 #include "CutsceneState.h"
+#include "../Geoscape/DogfightBenchmark.h"
+#include "../Mod/Mod.h"
+#include "../Mod/TechDependencyGraph.h"
 #include <SDL_mixer.h>
 #include <SDL_thread.h>
 
@@ -172,6 +175,31 @@ void StartState::think()
 		loading = LOADING_DONE;
 		break;
 	case LOADING_SUCCESSFUL:
+		if (!Options::getDogfightBenchmark().empty())
+		{
+			// batch mode: just run the simulations and leave
+			if (!DogfightBenchmark::run(_game->getMod(), Options::getDogfightBenchmark()))
+				_game->setExitCode(EXIT_FAILURE);
+			loading = LOADING_DONE;
+			_game->quit();
+			break;
+		}
+		if (!Options::getExportTechGraph().empty())
+		{
+			// batch mode: just write the graph and leave
+			if (_game->getMod()->getTechDependencyGraph()->exportFile(Options::getExportTechGraph()))
+			{
+				Log(LOG_INFO) << "Tech dependency graph exported to " << Options::getExportTechGraph();
+			}
+			else
+			{
+				Log(LOG_ERROR) << "Failed to export the tech dependency graph to " << Options::getExportTechGraph();
+				_game->setExitCode(EXIT_FAILURE);
+			}
+			loading = LOADING_DONE;
+			_game->quit();
+			break;
+		}
 		CrossPlatform::flashWindow();
 		Log(LOG_INFO) << "OpenXcom started successfully!";
 		_game->setState(new GoToMainMenuState(true));
@@ -183,7 +183,7 @@ void AlienDeployment::load(const YAML::YamlNodeReader& node, Mod *mod)
 	reader.tryRead("genMissionLimit", _genMissionLimit);
 	reader.tryRead("genMissionRaceFromAlienBase", _genMissionRaceFromAlienBase);
 
-	reader.tryRead("baseSelfDestructCode", _baseSelfDestructCode);
+	reader.tryRead("baseSelfDestructCode", _baseSelfDestructCodeName);
 	reader.tryRead("baseDetectionRange", _baseDetectionRange);
 	reader.tryRead("baseDetectionChance", _baseDetectionChance);
 	reader.tryRead("huntMissionMaxFrequency", _huntMissionMaxFrequency);
@@ -206,6 +206,14 @@ void AlienDeployment::load(const YAML::YamlNodeReader& node, Mod *mod)
 	reader.tryRead("noWeaponPile", _noWeaponPile);
 }
 
+/**
+ * Cross link with other rules.
+ */
+void AlienDeployment::afterLoad(const Mod* mod)
+{
+	mod->linkRule(_baseSelfDestructCode, _baseSelfDestructCodeName);
+}
+
 /**
  * Returns the language string that names
  * this deployment. Each deployment type has a unique name.
@@ -759,9 +767,9 @@ std::string AlienDeployment::generateHuntMission(const size_t monthsPassed) cons
 
 /**
  * Returns the Alien Base self destruct code.
- * @return String ID of the corresponding research topic.
+ * @return The corresponding research topic, or null.
  */
-const std::string& AlienDeployment::getBaseSelfDestructCode() const
+const RuleResearch* AlienDeployment::getBaseSelfDestructCode() const
 {
 	return _baseSelfDestructCode;
 }
@@ -27,6 +27,7 @@ namespace OpenXcom
 {
 
 class RuleTerrain;
+class RuleResearch;
 class Mod;
 
 struct ItemSet
@@ -128,7 +129,8 @@ private:
 	bool _keepCraftAfterFailedMission, _allowObjectiveRecovery;
 	EscapeType _escapeType;
 	int _vipSurvivalPercentage;
-	std::string _baseSelfDestructCode;
+	std::string _baseSelfDestructCodeName;
+	const RuleResearch* _baseSelfDestructCode = nullptr;
 	int _baseDetectionRange, _baseDetectionChance, _huntMissionMaxFrequency;
 	bool _huntMissionRaceFromAlienBase;
 	std::vector<std::pair<size_t, WeightedOptions*> > _huntMissionDistribution;
@@ -143,6 +145,8 @@ public:
 	~AlienDeployment();
 	/// Loads Alien Deployment data from YAML.
 	void load(const YAML::YamlNodeReader& node, Mod *mod);
+	/// Cross link with other rules.
+	void afterLoad(const Mod* mod);
 	/// Gets the Alien Deployment's type.
 	const std::string& getType() const;
 	/// Gets the custom UFO name to use for the dummy/blank 'addUFO' mapscript command.
@@ -295,7 +299,7 @@ public:
 	/// Generates a hunt mission based on the given month.
 	std::string generateHuntMission(const size_t monthsPassed) const;
 	/// Gets the Alien Base self destruct code.
-	const std::string& getBaseSelfDestructCode() const;
+	const RuleResearch* getBaseSelfDestructCode() const;
 	/// Gets the detection range of an alien base.
 	double getBaseDetectionRange() const;
 	/// Gets the chance of an alien base to detect a player's craft (once every 10 minutes).
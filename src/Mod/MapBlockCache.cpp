@@ -0,0 +1,242 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MapBlockCache.h"
+#include <algorithm>
+#include <map>
+#include "Mod.h"
+#include "MapBlock.h"
+#include "RuleGlobe.h"
+#include "RuleTerrain.h"
+#include "Texture.h"
+#include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Gets the memory used by the files of a block.
+ */
+template<typename E>
+size_t getEntryBytes(const E &entry)
+{
+	return (entry.tiles ? entry.tiles->tiles.size() : 0) + (entry.routes ? entry.routes->nodes.size() : 0);
+}
+
+}
+
+/**
+ * Makes room for new data of a block, dropping
+ * the blocks used the longest time ago.
+ * @param block Map block name.
+ * @param bytes Size of the new data.
+ * @return Entry of the block, or nullptr if the data isn't kept.
+ */
+MapBlockCache::Entry *MapBlockCache::reserve(const std::string &block, size_t bytes)
+{
+	size_t maxBytes = (size_t)std::max(0, Options::oxceMapBlockCache) * 1024 * 1024;
+	if (bytes > maxBytes)
+	{
+		return nullptr;
+	}
+	Entry &entry = _entries[block];
+	while (_bytes + bytes > maxBytes)
+	{
+		auto oldest = _entries.end();
+		for (auto it = _entries.begin(); it != _entries.end(); ++it)
+		{
+			if (&it->second != &entry && (oldest == _entries.end() || it->second.lastUse < oldest->second.lastUse))
+			{
+				oldest = it;
+			}
+		}
+		if (oldest == _entries.end())
+		{
+			break;
+		}
+		_bytes -= getEntryBytes(oldest->second);
+		_entries.erase(oldest);
+	}
+	entry.lastUse = ++_clock;
+	_bytes += bytes;
+	return &entry;
+}
+
+/**
+ * Gets the tiles of a map block, reading its MAP file if
+ * they aren't in the cache.
+ * @param block Map block name.
+ * @return Tiles of the block.
+ */
+std::shared_ptr<const MapBlockTiles> MapBlockCache::getTiles(const std::string &block)
+{
+	auto it = _entries.find(block);
+	if (it != _entries.end() && it->second.tiles)
+	{
+		it->second.lastUse = ++_clock;
+		return it->second.tiles;
+	}
+
+	std::string filename = "MAPS/" + block + ".MAP";
+	auto mapFile = FileMap::getIStream(filename);
+	char size[3];
+	if (!mapFile->read(size, sizeof(size)))
+	{
+		throw Exception("Invalid MAP file: " + filename);
+	}
+	auto tiles = std::make_shared<MapBlockTiles>();
+	tiles->sizeY = (int)size[0];
+	tiles->sizeX = (int)size[1];
+	tiles->sizeZ = (int)size[2];
+	unsigned char value[4];
+	while (mapFile->read((char*)&value, sizeof(value)))
+	{
+		tiles->tiles.insert(tiles->tiles.end(), value, value + sizeof(value));
+	}
+	if (!mapFile->eof())
+	{
+		throw Exception("Invalid MAP file: " + filename);
+	}
+
+	Entry *entry = reserve(block, tiles->tiles.size());
+	if (entry)
+	{
+		entry->tiles = tiles;
+	}
+	return tiles;
+}
+
+/**
+ * Gets the nodes of a map block, reading its RMP file if
+ * they aren't in the cache.
+ * @param block Map block name.
+ * @return Nodes of the block.
+ */
+std::shared_ptr<const MapBlockRoutes> MapBlockCache::getRoutes(const std::string &block)
+{
+	auto it = _entries.find(block);
+	if (it != _entries.end() && it->second.routes)
+	{
+		it->second.lastUse = ++_clock;
+		return it->second.routes;
+	}
+
+	std::string filename = "ROUTES/" + block + ".RMP";
+	auto mapFile = FileMap::getIStream(filename);
+	auto routes = std::make_shared<MapBlockRoutes>();
+	unsigned char value[24];
+	while (mapFile->read((char*)&value, sizeof(value)))
+	{
+		routes->nodes.insert(routes->nodes.end(), value, value + sizeof(value));
+	}
+	if (!mapFile->eof())
+	{
+		throw Exception("Invalid RMP file: " + filename);
+	}
+
+	Entry *entry = reserve(block, routes->nodes.size());
+	if (entry)
+	{
+		entry->routes = routes;
+	}
+	return routes;
+}
+
+/**
+ * Checks if both files of a map block are in the cache.
+ * @param block Map block name.
+ * @return True if the block won't be read again.
+ */
+bool MapBlockCache::hasBlock(const std::string &block) const
+{
+	auto it = _entries.find(block);
+	return it != _entries.end() && it->second.tiles && it->second.routes;
+}
+
+/**
+ * Reads the map blocks of the terrains the globe textures pick most
+ * often, until half the cache is used, so the first missions of the
+ * session start fast too.
+ * @param mod Pointer to the loaded mod.
+ */
+void MapBlockCache::warm(const Mod *mod)
+{
+	size_t maxBytes = (size_t)std::max(0, Options::oxceMapBlockCache) * 1024 * 1024;
+	std::map<std::string, int> weights;
+	for (const auto &pair : mod->getGlobe()->getTexturesRaw())
+	{
+		for (const auto &criteria : *pair.second->getTerrain())
+		{
+			weights[criteria.name] += criteria.weight;
+		}
+	}
+	std::vector<std::pair<int, std::string> > terrains;
+	for (const auto &pair : weights)
+	{
+		terrains.push_back(std::make_pair(-pair.second, pair.first));
+	}
+	std::sort(terrains.begin(), terrains.end());
+
+	Uint32 start = SDL_GetTicks();
+	for (const auto &pair : terrains)
+	{
+		RuleTerrain *terrain = mod->getTerrain(pair.second);
+		if (!terrain)
+		{
+			continue;
+		}
+		for (const auto *block : *terrain->getMapBlocks())
+		{
+			if (_bytes >= maxBytes / 2)
+			{
+				break;
+			}
+			if (!FileMap::fileExists("MAPS/" + block->getName() + ".MAP") || !FileMap::fileExists("ROUTES/" + block->getName() + ".RMP"))
+			{
+				continue;
+			}
+			try
+			{
+				getTiles(block->getName());
+				getRoutes(block->getName());
+			}
+			catch (Exception &e)
+			{
+				Log(LOG_WARNING) << "Map block cache: " << e.what();
+			}
+		}
+	}
+	Log(LOG_INFO) << "Map block cache: " << _entries.size() << " blocks, " << _bytes << " bytes read in " << (SDL_GetTicks() - start) << " ms.";
+}
+
+/**
+ * Empties the cache.
+ */
+void MapBlockCache::clear()
+{
+	_entries.clear();
+	_bytes = 0;
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL.h>
+
+namespace OpenXcom
+{
+
+class Mod;
+class RuleTerrain;
+
+/**
+ * Contents of a MAP file: the block size and
+ * 4 terrain object IDs per tile, in file order.
+ */
+struct MapBlockTiles
+{
+	int sizeX, sizeY, sizeZ;
+	std::vector<Uint8> tiles;
+};
+
+/**
+ * Contents of an RMP file: 24 bytes per node, in file order.
+ */
+struct MapBlockRoutes
+{
+	std::vector<Uint8> nodes;
+};
+
+/**
+ * Size bounded cache of the MAP and RMP files read by the battlescape generator,
+ * keyed by map block name. The files are immutable mod data, so later missions
+ * using the same blocks don't read them again. When full, the blocks used the
+ * longest time ago are dropped.
+ */
+class MapBlockCache
+{
+private:
+	struct Entry
+	{
+		std::shared_ptr<const MapBlockTiles> tiles;
+		std::shared_ptr<const MapBlockRoutes> routes;
+		Uint64 lastUse = 0;
+	};
+	std::unordered_map<std::string, Entry> _entries;
+	size_t _bytes = 0;
+	Uint64 _clock = 0;
+
+	/// Makes room for new data of a block.
+	Entry *reserve(const std::string &block, size_t bytes);
+public:
+	/// Gets the tiles of a map block, reading its MAP file if needed.
+	std::shared_ptr<const MapBlockTiles> getTiles(const std::string &block);
+	/// Gets the nodes of a map block, reading its RMP file if needed.
+	std::shared_ptr<const MapBlockRoutes> getRoutes(const std::string &block);
+	/// Checks if both files of a map block are in the cache.
+	bool hasBlock(const std::string &block) const;
+	/// Reads the map blocks of the terrains most used by the globe textures.
+	void warm(const Mod *mod);
+	/// Empties the cache.
+	void clear();
+};
+
+}
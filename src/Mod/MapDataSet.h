@@ -62,6 +62,8 @@ public:
 	void loadData(MCDPatch *patch, bool validate = true);
 	///	Unloads to free memory.
 	void unloadData();
+	/// Checks if the objects and sprites are loaded.
+	bool isLoaded() const { return _loaded; }
 	/// Gets a blank floor tile.
 	static MapData *getBlankFloorTile();
 	/// Gets a scorched earth tile.
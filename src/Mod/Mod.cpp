@@ -34,6 +34,7 @@
 #include "../Engine/GMCat.h"
 #include "../Engine/SoundSet.h"
 #include "../Engine/Sound.h"
+#include "../Interface/Text.h"
 #include "../Interface/TextButton.h"
 #include "../Interface/Window.h"
 #include "MapDataSet.h"
@@ -76,6 +77,8 @@
 #include "ArticleDefinition.h"
 #include "RuleInventory.h"
 #include "RuleResearch.h"
+#include "TechDependencyGraph.h"
+#include "MapBlockCache.h"
 #include "RuleManufacture.h"
 #include "RuleManufactureShortcut.h"
 #include "ExtraStrings.h"
@@ -593,7 +596,11 @@ Mod::~Mod()
 {
 	delete _muteMusic;
 	delete _muteSound;
+	delete _techDependencyGraph;
+	delete _mapBlockCache;
 	delete _globe;
+	// cached texts refer to the fonts
+	Text::clearCache();
 	delete _converter;
 	delete _scriptGlobal;
 	for (auto& pair : _fonts)
@@ -2292,6 +2299,14 @@ void Mod::loadAll()
 	// cross link rule objects
 
 	afterLoadHelper("research", this, _research, &RuleResearch::afterLoad);
+	{
+		// dense indexes, so the saved game can keep discovered research in a bitset
+		int index = 0;
+		for (auto& pair : _research)
+		{
+			pair.second->setIndex(index++);
+		}
+	}
 	afterLoadHelper("items", this, _items, &RuleItem::afterLoad);
 	afterLoadHelper("weaponSets", this, _weaponSets, &RuleWeaponSet::afterLoad);
 	afterLoadHelper("manufacture", this, _manufacture, &RuleManufacture::afterLoad);
@@ -2306,6 +2321,12 @@ void Mod::loadAll()
 	afterLoadHelper("craftWeapons", this, _craftWeapons, &RuleCraftWeapon::afterLoad);
 	afterLoadHelper("countries", this, _countries, &RuleCountry::afterLoad);
 	afterLoadHelper("crafts", this, _crafts, &RuleCraft::afterLoad);
+	afterLoadHelper("alienDeployments", this, _alienDeployments, &AlienDeployment::afterLoad);
+	afterLoadHelper("alienMissions", this, _alienMissions, &RuleAlienMission::afterLoad);
+	afterLoadHelper("events", this, _events, &RuleEvent::afterLoad);
+	afterLoadHelper("arcScripts", this, _arcScripts, &RuleArcScript::afterLoad);
+	afterLoadHelper("eventScripts", this, _eventScripts, &RuleEventScript::afterLoad);
+	afterLoadHelper("missionScripts", this, _missionScripts, &RuleMissionScript::afterLoad);
 
 	for (auto& a : _armors)
 	{
@@ -2455,7 +2476,21 @@ void Mod::loadAll()
 	Log(LOG_INFO) << "Loading ended.";
 
 	sortLists();
+	if (!_techDependencyGraph)
+	{
+		_techDependencyGraph = new TechDependencyGraph();
+	}
+	_techDependencyGraph->build(this);
 	modResources();
+	if (!_mapBlockCache)
+	{
+		_mapBlockCache = new MapBlockCache();
+	}
+	_mapBlockCache->clear();
+	if (Options::oxceMapBlockCacheWarmup)
+	{
+		_mapBlockCache->warm(this);
+	}
 }
 
 /**
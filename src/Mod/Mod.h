@@ -70,6 +70,8 @@ class Armor;
 class ArticleDefinition;
 class RuleInventory;
 class RuleResearch;
+class TechDependencyGraph;
+class MapBlockCache;
 class RuleManufacture;
 class RuleManufactureShortcut;
 class RuleSoldierBonus;
@@ -315,6 +317,8 @@ private:
 	std::vector<const Armor*> _armorsForSoldiersCache;
 	std::vector<const RuleItem*> _armorStorageItemsCache;
 	std::vector<const RuleItem*> _craftWeaponStorageItemsCache;
+	TechDependencyGraph *_techDependencyGraph = nullptr;
+	MapBlockCache *_mapBlockCache = nullptr;
 	/// Track of what mod create rule object.
 	std::unordered_map<const void*, const ModData*> _ruleCreationTracking;
 	/// Track of what mod last update rule object.
@@ -976,6 +980,10 @@ public:
 	const std::map<std::string, RuleResearch *> &getResearchMap() const;
 	/// Gets the list of all research projects.
 	const std::vector<std::string> &getResearchList() const;
+	/// Gets the relations between research, manufacture, facilities, items and crafts.
+	const TechDependencyGraph *getTechDependencyGraph() const { return _techDependencyGraph; }
+	/// Gets the cache of the map block files.
+	MapBlockCache *getMapBlockCache() const { return _mapBlockCache; }
 	/// Gets the ruleset for a specific manufacture project.
 	RuleManufacture *getManufacture (const std::string &id, bool error = false) const;
 	/// Gets the list of all manufacture projects.
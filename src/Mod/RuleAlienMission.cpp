@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleAlienMission.h"
+#include "Mod.h"
 #include "../Savegame/WeightedOptions.h"
 
 namespace OpenXcom
@@ -79,7 +80,7 @@ void RuleAlienMission::load(const YAML::YamlNodeReader& node)
 	reader.tryRead("despawnEvenIfTargeted", _despawnEvenIfTargeted);
 	reader.tryRead("respawnUfoAfterSiteDespawn", _respawnUfoAfterSiteDespawn);
 	reader.tryRead("showAlienBase", _showAlienBase);
-	reader.tryRead("interruptResearch", _interruptResearch);
+	reader.tryRead("interruptResearch", _interruptResearchName);
 	reader.tryRead("siteType", _siteType);
 	reader.tryRead("operationType", _operationType);
 	reader.tryRead("operationSpawnZone", _operationSpawnZone);
@@ -144,6 +145,14 @@ void RuleAlienMission::load(const YAML::YamlNodeReader& node)
 	}
 }
 
+/**
+ * Cross link with other rules.
+ */
+void RuleAlienMission::afterLoad(const Mod* mod)
+{
+	mod->linkRule(_interruptResearch, _interruptResearchName);
+}
+
 /**
  * @return if this mission uses a weighted distribution to pick a race.
  */
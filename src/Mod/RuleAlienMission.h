@@ -36,6 +36,8 @@ enum AlienMissionOperationType {
 };
 
 class WeightedOptions;
+class RuleResearch;
+class Mod;
 
 /**
  * @brief Information about a mission wave.
@@ -133,6 +135,8 @@ public:
 	std::string generateRace(const size_t monthsPassed) const;
 	/// Loads alien mission data from YAML.
 	void load(const YAML::YamlNodeReader& reader);
+	/// Cross link with other rules.
+	void afterLoad(const Mod* mod);
 	/// Gets the number of waves.
 	size_t getWaveCount() const { return _waves.size(); }
 	/// Gets the full wave information.
@@ -166,7 +170,7 @@ public:
 	/// Should the spawned alien base be revealed immediately?
 	bool showAlienBase() const { return _showAlienBase; }
 	/// Gets the ID of the research topic that interrupts this mission (if any).
-	const std::string &getInterruptResearch() const { return _interruptResearch; }
+	const RuleResearch* getInterruptResearch() const { return _interruptResearch; }
 	/// the type of missionSite to spawn (if any)
 	std::string getSiteType() const { return _siteType; }
 	/// From where does this mission operate?
@@ -217,7 +221,8 @@ private:
 	/// Should the spawned alien base be revealed immediately?
 	bool _showAlienBase;
 	/// the research topic that interrupts this mission type (when discovered)
-	std::string _interruptResearch;
+	std::string _interruptResearchName;
+	const RuleResearch* _interruptResearch = nullptr;
 	/// the type of missionSite to spawn (if any)
 	std::string _siteType;
 	/// From where does this mission operate?
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleArcScript.h"
+#include "Mod.h"
 #include <climits>
 
 namespace OpenXcom
@@ -78,4 +79,16 @@ void RuleArcScript::load(const YAML::YamlNodeReader& node)
 	reader.tryRead("xcomBaseInCountryTriggers", _xcomBaseInCountryTriggers);
 }
 
+/**
+ * Cross link with other rules.
+ */
+void RuleArcScript::afterLoad(const Mod* mod)
+{
+	for (const auto& trigger : _researchTriggers)
+	{
+		// a topic that doesn't exist is never researched
+		_researchTriggerRules.push_back(std::make_pair(mod->getResearch(trigger.first, false), trigger.second));
+	}
+}
+
 }
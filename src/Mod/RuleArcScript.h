@@ -26,6 +26,9 @@
 namespace OpenXcom
 {
 
+class RuleResearch;
+class Mod;
+
 class RuleArcScript
 {
 private:
@@ -38,6 +41,7 @@ private:
 	std::string _missionVarName, _missionMarkerName;
 	int _counterMin, _counterMax;
 	std::map<std::string, bool> _researchTriggers;
+	std::vector<std::pair<const RuleResearch*, bool> > _researchTriggerRules;
 	std::map<std::string, bool> _itemTriggers;
 	std::map<std::string, bool> _facilityTriggers;
 	std::map<std::string, bool> _xcomBaseInRegionTriggers;
@@ -49,6 +53,8 @@ public:
 	~RuleArcScript();
 	/// Loads an arc script from yaml.
 	void load(const YAML::YamlNodeReader& reader);
+	/// Cross link with other rules.
+	void afterLoad(const Mod* mod);
 	/// Gets the name of the script command.
 	const std::string &getType() const { return _type; }
 	/// Gets the sequential arcs list.
@@ -85,6 +91,8 @@ public:
 	int getCounterMax() const { return _counterMax; }
 	/// Gets the research triggers that may apply to this command.
 	const std::map<std::string, bool> &getResearchTriggers() const { return _researchTriggers; }
+	/// Gets the research triggers linked to their rules; unknown topics are null.
+	const std::vector<std::pair<const RuleResearch*, bool> > &getResearchTriggerRules() const { return _researchTriggerRules; }
 	/// Gets the item triggers that may apply to this command.
 	const std::map<std::string, bool> &getItemTriggers() const { return _itemTriggers; }
 	/// Gets the facility triggers that may apply to this command.
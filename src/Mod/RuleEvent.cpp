@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleEvent.h"
+#include "Mod.h"
 
 namespace OpenXcom
 {
@@ -65,10 +66,18 @@ void RuleEvent::load(const YAML::YamlNodeReader& node)
 		_weightedItemList.load(reader["weightedItemList"]);
 	}
 	reader.tryRead("researchList", _researchList);
-	reader.tryRead("interruptResearch", _interruptResearch);
+	reader.tryRead("interruptResearch", _interruptResearchName);
 	reader.tryRead("timer", _timer);
 	reader.tryRead("timerRandom", _timerRandom);
 	reader.tryRead("invert", _invert);
 }
 
+/**
+ * Cross link with other rules.
+ */
+void RuleEvent::afterLoad(const Mod* mod)
+{
+	mod->linkRule(_interruptResearch, _interruptResearchName);
+}
+
 }
@@ -26,6 +26,9 @@
 namespace OpenXcom
 {
 
+class RuleResearch;
+class Mod;
+
 /**
  * Represents a custom Geoscape event.
  * Events are spawned using Event Script ruleset.
@@ -47,7 +50,8 @@ private:
 	std::vector<std::map<std::string, int> > _randomMultiItemList;
 	WeightedOptions _weightedItemList;
 	std::vector<std::string> _researchList;
-	std::string _interruptResearch;
+	std::string _interruptResearchName;
+	const RuleResearch* _interruptResearch = nullptr;
 	int _timer, _timerRandom;
 	bool _invert;
 public:
@@ -57,6 +61,8 @@ public:
 	~RuleEvent() = default;
 	/// Loads the event definition from YAML.
 	void load(const YAML::YamlNodeReader& reader);
+	/// Cross link with other rules.
+	void afterLoad(const Mod* mod);
 	/// Gets the event's name.
 	const std::string &getName() const { return _name; }
 	/// Gets the event's description.
@@ -103,7 +109,7 @@ public:
 	/// Gets a list of research projects; one of them will be randomly discovered when this event pops up.
 	const std::vector<std::string> &getResearchList() const { return _researchList; }
 	/// Gets the research project that will interrupt/terminate an already generated (but not yet popped up) event.
-	const std::string &getInterruptResearch() const { return _interruptResearch; }
+	const RuleResearch* getInterruptResearch() const { return _interruptResearch; }
 	/// Gets the timer of delay for this event, for it occurring after being spawned with eventScripts ruleset.
 	int getTimer() const { return _timer; }
 	/// Gets value for calculation of random part of delay for this event.
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleEventScript.h"
+#include "Mod.h"
 #include <climits>
 
 namespace OpenXcom
@@ -96,6 +97,18 @@ void RuleEventScript::load(const YAML::YamlNodeReader& node)
 	reader.tryRead("affectsGameProgression", _affectsGameProgression);
 }
 
+/**
+ * Cross link with other rules.
+ */
+void RuleEventScript::afterLoad(const Mod* mod)
+{
+	for (const auto& trigger : _researchTriggers)
+	{
+		// a topic that doesn't exist is never researched
+		_researchTriggerRules.push_back(std::make_pair(mod->getResearch(trigger.first, false), trigger.second));
+	}
+}
+
 /**
  * Chooses one of the available events for this command.
  * @param monthsPassed The number of months that have passed in the game world.
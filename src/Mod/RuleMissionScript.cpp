@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleMissionScript.h"
+#include "Mod.h"
 #include "../Engine/Exception.h"
 #include "../Engine/RNG.h"
 #include <climits>
@@ -120,6 +121,18 @@ void RuleMissionScript::load(const YAML::YamlNodeReader& node)
 
 }
 
+/**
+ * Cross link with other rules.
+ */
+void RuleMissionScript::afterLoad(const Mod* mod)
+{
+	for (const auto& trigger : _researchTriggers)
+	{
+		// a topic that doesn't exist is never researched
+		_researchTriggerRules.push_back(std::make_pair(mod->getResearch(trigger.first, false), trigger.second));
+	}
+}
+
 /**
  * Gets the name of this command.
  * @return the name of the command.
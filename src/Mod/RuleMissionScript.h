@@ -28,6 +28,8 @@ namespace OpenXcom
 {
 enum GenerationType { GEN_REGION, GEN_MISSION, GEN_RACE };
 class WeightedOptions;
+class RuleResearch;
+class Mod;
 
 class RuleMissionScript
 {
@@ -41,6 +43,7 @@ private:
 	std::vector<int> _conditionals;
 	std::vector<std::pair<size_t, WeightedOptions*> > _regionWeights, _missionWeights, _raceWeights;
 	std::map<std::string, bool> _researchTriggers;
+	std::vector<std::pair<const RuleResearch*, bool> > _researchTriggerRules;
 	std::map<std::string, bool> _itemTriggers;
 	std::map<std::string, bool> _facilityTriggers;
 	std::map<std::string, bool> _xcomBaseInRegionTriggers;
@@ -53,6 +56,8 @@ public:
 	~RuleMissionScript();
 	/// Loads a mission script from yaml.
 	void load(const YAML::YamlNodeReader& reader);
+	/// Cross link with other rules.
+	void afterLoad(const Mod* mod);
 	/// Gets the name of the script command.
 	const std::string& getType() const;
 	/// Gets the name of the variable to use for keeping track of... things.
@@ -109,6 +114,8 @@ public:
 	bool hasRegionWeights() const;
 	/// Gets the research triggers that may apply to this command.
 	const std::map<std::string, bool> &getResearchTriggers() const;
+	/// Gets the research triggers linked to their rules; unknown topics are null.
+	const std::vector<std::pair<const RuleResearch*, bool> > &getResearchTriggerRules() const { return _researchTriggerRules; }
 	/// Gets the item triggers that may apply to this command.
 	const std::map<std::string, bool> &getItemTriggers() const;
 	/// Gets the facility triggers that may apply to this command.
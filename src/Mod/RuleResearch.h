@@ -59,6 +59,7 @@ class RuleResearch
 	bool _needItem, _destroyItem, _unlockFinalMission;
 	bool _repeatable;
 	int _listOrder;
+	int _index = -1;
 
 	ScriptValues<RuleResearch> _scriptValues;
 public:
@@ -116,6 +117,10 @@ public:
 	RuleBaseFacilityFunctions getRequireBaseFunc() const { return _requiresBaseFunc; }
 	/// Gets the list weight for this research item.
 	int getListOrder() const;
+	/// Gets the dense index of this research, assigned after loading all rules.
+	int getIndex() const { return _index; }
+	/// Sets the dense index of this research.
+	void setIndex(int index) { _index = index; }
 	/// Gets the cutscene to play when this item is researched
 	const std::string & getCutscene() const;
 	/// Gets the item to spawn in the base stores when this topic is researched.
@@ -0,0 +1,432 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TechDependencyGraph.h"
+#include <algorithm>
+#include <sstream>
+#include "Mod.h"
+#include "RuleArcScript.h"
+#include "RuleBaseFacility.h"
+#include "RuleCraft.h"
+#include "RuleEventScript.h"
+#include "RuleItem.h"
+#include "RuleManufacture.h"
+#include "RuleMissionScript.h"
+#include "RuleResearch.h"
+#include "RuleSoldierTransformation.h"
+#include "../Engine/CrossPlatform.h"
+
+namespace OpenXcom
+{
+
+const TechResearchLinks TechDependencyGraph::_emptyResearchLinks;
+const TechItemLinks TechDependencyGraph::_emptyItemLinks;
+const std::string TechDependencyGraph::_emptyName;
+
+namespace
+{
+
+const char *nodeKindName(TechNodeKind kind)
+{
+	switch (kind)
+	{
+	case TNK_RESEARCH: return "research";
+	case TNK_MANUFACTURE: return "manufacture";
+	case TNK_FACILITY: return "facility";
+	case TNK_ITEM: return "item";
+	case TNK_CRAFT: return "craft";
+	case TNK_TRANSFORMATION: return "transformation";
+	}
+	return "";
+}
+
+const char *edgeKindName(TechEdgeKind kind)
+{
+	switch (kind)
+	{
+	case TEK_DEPENDENCY: return "dependency";
+	case TEK_REQUIREMENT: return "requires";
+	case TEK_BUY_REQUIREMENT: return "requiresBuy";
+	case TEK_UNLOCK: return "unlocks";
+	case TEK_DISABLE: return "disables";
+	case TEK_REENABLE: return "reenables";
+	case TEK_GET_ONE_FREE: return "getOneFree";
+	case TEK_LOOKUP: return "lookup";
+	case TEK_PRODUCES: return "produces";
+	case TEK_SPAWNS: return "spawns";
+	case TEK_INPUT: return "input";
+	case TEK_BUILD_COST: return "buildCost";
+	}
+	return "";
+}
+
+/**
+ * Escapes a string for a quoted DOT id.
+ * DOT only escapes quotes and takes control characters raw. Backslashes
+ * are doubled too, so a name ending in one can't escape the closing quote.
+ */
+std::string dotQuote(const std::string &s)
+{
+	std::string result = "\"";
+	for (char c : s)
+	{
+		if (c == '"' || c == '\\')
+		{
+			result += '\\';
+		}
+		result += c;
+	}
+	result += '"';
+	return result;
+}
+
+/**
+ * Escapes a string for a JSON string.
+ * Control characters become \\uXXXX, as JSON doesn't allow them raw.
+ */
+std::string jsonQuote(const std::string &s)
+{
+	static const char hex[] = "0123456789abcdef";
+	std::string result = "\"";
+	for (char c : s)
+	{
+		if ((unsigned char)c < 0x20)
+		{
+			result += "\\u00";
+			result += hex[(unsigned char)c >> 4];
+			result += hex[c & 0xf];
+			continue;
+		}
+		if (c == '"' || c == '\\')
+		{
+			result += '\\';
+		}
+		result += c;
+	}
+	result += '"';
+	return result;
+}
+
+std::string nodeId(TechNodeKind kind, const std::string &name)
+{
+	return dotQuote(std::string(nodeKindName(kind)) + ":" + name);
+}
+
+}
+
+/**
+ * Collects the relations of all research, manufacture, facility,
+ * item, craft, soldier transformation and script rules. Lists
+ * are walked in the mod's sorted order, so every reverse list
+ * comes out in the order the tech tree viewer has always shown.
+ * @param mod Mod with all the rules loaded and sorted.
+ */
+void TechDependencyGraph::build(const Mod *mod)
+{
+	_research.clear();
+	_items.clear();
+	_craftProducedBy.clear();
+	_edges.clear();
+
+	auto addEdge = [&](TechNodeKind fromKind, const std::string &from, TechNodeKind toKind, const std::string &to, TechEdgeKind kind)
+	{
+		_edges.push_back(TechEdge{ fromKind, toKind, from, to, kind });
+	};
+
+	for (const auto &name : mod->getManufactureList())
+	{
+		const RuleManufacture *rule = mod->getManufacture(name);
+		for (const auto *res : rule->getRequirements())
+		{
+			_research[res->getName()].requiredByManufacture.push_back(name);
+			addEdge(TNK_RESEARCH, res->getName(), TNK_MANUFACTURE, name, TEK_REQUIREMENT);
+		}
+		for (const auto &pair : rule->getRequiredItems())
+		{
+			_items[pair.first->getType()].usedByManufacture.push_back(name);
+			addEdge(TNK_ITEM, pair.first->getType(), TNK_MANUFACTURE, name, TEK_INPUT);
+		}
+		// every item produced, fixed or random, counted once per project
+		std::vector<const RuleItem*> produced;
+		for (const auto &pair : rule->getProducedItems())
+		{
+			produced.push_back(pair.first);
+		}
+		for (const auto &randomOutput : rule->getRandomProducedItems())
+		{
+			for (const auto &pair : randomOutput.second)
+			{
+				if (std::find(produced.begin(), produced.end(), pair.first) == produced.end())
+				{
+					produced.push_back(pair.first);
+				}
+			}
+		}
+		for (const auto *item : produced)
+		{
+			_items[item->getType()].producedBy.push_back(name);
+			addEdge(TNK_MANUFACTURE, name, TNK_ITEM, item->getType(), TEK_PRODUCES);
+		}
+		if (rule->getProducedCraft())
+		{
+			_craftProducedBy.insert(std::make_pair(rule->getProducedCraft()->getType(), name));
+			addEdge(TNK_MANUFACTURE, name, TNK_CRAFT, rule->getProducedCraft()->getType(), TEK_PRODUCES);
+		}
+	}
+
+	for (const auto &name : mod->getBaseFacilitiesList())
+	{
+		const RuleBaseFacility *rule = mod->getBaseFacility(name);
+		for (const auto &res : rule->getRequirements())
+		{
+			_research[res].requiredByFacilities.push_back(name);
+			addEdge(TNK_RESEARCH, res, TNK_FACILITY, name, TEK_REQUIREMENT);
+		}
+		for (const auto &pair : rule->getBuildCostItems())
+		{
+			_items[pair.first].usedByFacilities.push_back(name);
+			addEdge(TNK_ITEM, pair.first, TNK_FACILITY, name, TEK_BUILD_COST);
+		}
+	}
+
+	for (const auto &name : mod->getItemsList())
+	{
+		const RuleItem *rule = mod->getItem(name);
+		for (const auto *res : rule->getRequirements())
+		{
+			_research[res->getName()].requiredByItems.push_back(name);
+			addEdge(TNK_RESEARCH, res->getName(), TNK_ITEM, name, TEK_REQUIREMENT);
+		}
+		for (const auto *res : rule->getBuyRequirements())
+		{
+			_research[res->getName()].requiredByItems.push_back(name);
+			addEdge(TNK_RESEARCH, res->getName(), TNK_ITEM, name, TEK_BUY_REQUIREMENT);
+		}
+	}
+
+	for (const auto &name : mod->getSoldierTransformationList())
+	{
+		const RuleSoldierTransformation *rule = mod->getSoldierTransformation(name);
+		for (const auto &res : rule->getRequiredResearch())
+		{
+			_research[res].requiredByTransformations.push_back(name);
+			addEdge(TNK_RESEARCH, res, TNK_TRANSFORMATION, name, TEK_REQUIREMENT);
+		}
+	}
+
+	for (const auto &name : mod->getCraftsList())
+	{
+		const RuleCraft *rule = mod->getCraft(name);
+		for (const auto &res : rule->getRequirements())
+		{
+			_research[res].requiredByCrafts.push_back(name);
+			addEdge(TNK_RESEARCH, res, TNK_CRAFT, name, TEK_REQUIREMENT);
+		}
+	}
+
+	for (const auto &name : mod->getResearchList())
+	{
+		const RuleResearch *rule = mod->getResearch(name);
+		for (const auto *res : rule->getUnlocked())
+		{
+			_research[res->getName()].unlockedBy.push_back(name);
+			addEdge(TNK_RESEARCH, name, TNK_RESEARCH, res->getName(), TEK_UNLOCK);
+		}
+		for (const auto *res : rule->getDisabled())
+		{
+			_research[res->getName()].disabledBy.push_back(name);
+			addEdge(TNK_RESEARCH, name, TNK_RESEARCH, res->getName(), TEK_DISABLE);
+		}
+		for (const auto *res : rule->getReenabled())
+		{
+			_research[res->getName()].reenabledBy.push_back(name);
+			addEdge(TNK_RESEARCH, name, TNK_RESEARCH, res->getName(), TEK_REENABLE);
+		}
+		for (const auto *res : rule->getGetOneFree())
+		{
+			_research[res->getName()].getForFreeFrom.push_back(name);
+			addEdge(TNK_RESEARCH, name, TNK_RESEARCH, res->getName(), TEK_GET_ONE_FREE);
+		}
+		for (const auto &protectedList : rule->getGetOneFreeProtected())
+		{
+			for (const auto *res : protectedList.second)
+			{
+				_research[res->getName()].getForFreeFrom.push_back(name);
+				addEdge(TNK_RESEARCH, name, TNK_RESEARCH, res->getName(), TEK_GET_ONE_FREE);
+			}
+		}
+		if (!Mod::isEmptyRuleName(rule->getLookup()))
+		{
+			_research[rule->getLookup()].lookupOf.push_back(name);
+			addEdge(TNK_RESEARCH, name, TNK_RESEARCH, rule->getLookup(), TEK_LOOKUP);
+		}
+		for (const auto *res : rule->getRequirements())
+		{
+			_research[res->getName()].requiredByResearch.push_back(name);
+			addEdge(TNK_RESEARCH, res->getName(), TNK_RESEARCH, name, TEK_REQUIREMENT);
+		}
+		for (const auto *res : rule->getDependencies())
+		{
+			_research[res->getName()].leadsTo.push_back(name);
+			addEdge(TNK_RESEARCH, res->getName(), TNK_RESEARCH, name, TEK_DEPENDENCY);
+		}
+		// the fixed spawned item and the item list, counted once per topic
+		std::vector<std::string> spawned;
+		if (!rule->getSpawnedItem().empty())
+		{
+			spawned.push_back(rule->getSpawnedItem());
+		}
+		for (const auto &item : rule->getSpawnedItemList())
+		{
+			if (std::find(spawned.begin(), spawned.end(), item) == spawned.end())
+			{
+				spawned.push_back(item);
+			}
+		}
+		for (const auto &item : spawned)
+		{
+			_items[item].spawnedBy.push_back(name);
+			addEdge(TNK_RESEARCH, name, TNK_ITEM, item, TEK_SPAWNS);
+		}
+	}
+
+	for (const auto &name : *mod->getArcScriptList())
+	{
+		const RuleArcScript *rule = mod->getArcScript(name, false);
+		if (rule)
+		{
+			for (const auto &trigger : rule->getResearchTriggers())
+			{
+				_research[trigger.first].arcScripts.push_back(std::make_pair(name, trigger.second));
+			}
+		}
+	}
+	for (const auto &name : *mod->getEventScriptList())
+	{
+		const RuleEventScript *rule = mod->getEventScript(name, false);
+		if (rule)
+		{
+			for (const auto &trigger : rule->getResearchTriggers())
+			{
+				_research[trigger.first].eventScripts.push_back(std::make_pair(name, trigger.second));
+			}
+		}
+	}
+	for (const auto &name : *mod->getMissionScriptList())
+	{
+		const RuleMissionScript *rule = mod->getMissionScript(name, false);
+		if (rule)
+		{
+			for (const auto &trigger : rule->getResearchTriggers())
+			{
+				_research[trigger.first].missionScripts.push_back(std::make_pair(name, trigger.second));
+			}
+		}
+	}
+}
+
+/**
+ * Gets the rules that refer to a research topic.
+ * @param research Research name.
+ * @return Reverse links, empty if nothing refers to it.
+ */
+const TechResearchLinks &TechDependencyGraph::getResearchLinks(const std::string &research) const
+{
+	auto it = _research.find(research);
+	return it != _research.end() ? it->second : _emptyResearchLinks;
+}
+
+/**
+ * Gets the rules that refer to an item.
+ * @param item Item type.
+ * @return Reverse links, empty if nothing refers to it.
+ */
+const TechItemLinks &TechDependencyGraph::getItemLinks(const std::string &item) const
+{
+	auto it = _items.find(item);
+	return it != _items.end() ? it->second : _emptyItemLinks;
+}
+
+/**
+ * Gets the first manufacture project (in list order) producing a craft.
+ * @param craft Craft type.
+ * @return Manufacture name, empty if the craft can't be manufactured.
+ */
+const std::string &TechDependencyGraph::getCraftProducedBy(const std::string &craft) const
+{
+	auto it = _craftProducedBy.find(craft);
+	return it != _craftProducedBy.end() ? it->second : _emptyName;
+}
+
+/**
+ * Writes the graph in Graphviz DOT format, one node per
+ * rule ("kind:name") and one labelled edge per relation.
+ * @param out Output stream.
+ */
+void TechDependencyGraph::exportDot(std::ostream &out) const
+{
+	out << "digraph techtree {\n";
+	out << "\trankdir=LR;\n";
+	for (const auto &edge : _edges)
+	{
+		out << "\t" << nodeId(edge.fromKind, edge.from) << " -> " << nodeId(edge.toKind, edge.to) << " [label=" << dotQuote(edgeKindName(edge.kind)) << "];\n";
+	}
+	out << "}\n";
+}
+
+/**
+ * Writes the graph as a JSON object with an "edges" array,
+ * each edge having from/fromKind/to/toKind/kind fields.
+ * @param out Output stream.
+ */
+void TechDependencyGraph::exportJson(std::ostream &out) const
+{
+	out << "{\n\t\"edges\": [";
+	bool first = true;
+	for (const auto &edge : _edges)
+	{
+		out << (first ? "\n" : ",\n");
+		first = false;
+		out << "\t\t{ \"from\": " << jsonQuote(edge.from) << ", \"fromKind\": " << jsonQuote(nodeKindName(edge.fromKind))
+			<< ", \"to\": " << jsonQuote(edge.to) << ", \"toKind\": " << jsonQuote(nodeKindName(edge.toKind))
+			<< ", \"kind\": " << jsonQuote(edgeKindName(edge.kind)) << " }";
+	}
+	out << "\n\t]\n}\n";
+}
+
+/**
+ * Writes the graph to a file, picking the format from the extension.
+ * @param filename Output file, JSON if it ends with ".json", DOT otherwise.
+ * @return True if the file was written.
+ */
+bool TechDependencyGraph::exportFile(const std::string &filename) const
+{
+	std::ostringstream ss;
+	const std::string json = ".json";
+	if (filename.size() >= json.size() && filename.compare(filename.size() - json.size(), json.size(), json) == 0)
+	{
+		exportJson(ss);
+	}
+	else
+	{
+		exportDot(ss);
+	}
+	return CrossPlatform::writeFile(filename, ss.str());
+}
+
+}
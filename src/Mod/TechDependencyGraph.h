@@ -0,0 +1,103 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Mod;
+
+/// Kinds of rules in the tech dependency graph.
+enum TechNodeKind { TNK_RESEARCH, TNK_MANUFACTURE, TNK_FACILITY, TNK_ITEM, TNK_CRAFT, TNK_TRANSFORMATION };
+
+/// Kinds of relations in the tech dependency graph.
+enum TechEdgeKind { TEK_DEPENDENCY, TEK_REQUIREMENT, TEK_BUY_REQUIREMENT, TEK_UNLOCK, TEK_DISABLE, TEK_REENABLE, TEK_GET_ONE_FREE, TEK_LOOKUP, TEK_PRODUCES, TEK_SPAWNS, TEK_INPUT, TEK_BUILD_COST };
+
+/**
+ * One relation "from -> to", eg. research -> manufacture
+ * for a research required by a manufacture project.
+ */
+struct TechEdge
+{
+	TechNodeKind fromKind, toKind;
+	std::string from, to;
+	TechEdgeKind kind;
+};
+
+/**
+ * Everything that refers to one research topic, in mod list order.
+ */
+struct TechResearchLinks
+{
+	std::vector<std::string> unlockedBy, disabledBy, reenabledBy, getForFreeFrom, lookupOf, leadsTo;
+	std::vector<std::string> requiredByResearch, requiredByManufacture, requiredByFacilities, requiredByItems, requiredByTransformations, requiredByCrafts;
+	/// Scripts triggered (true) or blocked (false) by this research.
+	std::vector<std::pair<std::string, bool> > arcScripts, eventScripts, missionScripts;
+};
+
+/**
+ * Everything that refers to one item, in mod list order.
+ */
+struct TechItemLinks
+{
+	std::vector<std::string> producedBy, spawnedBy, usedByManufacture, usedByFacilities;
+};
+
+/**
+ * Research, manufacture, facility, item and craft relations of a mod,
+ * built once after loading. Holds the reverse links ("required by",
+ * "unlocked by", "produced by"...) that the rules don't store themselves,
+ * so the tech tree screens don't have to scan every rule on each click,
+ * plus the full edge list for exporting.
+ */
+class TechDependencyGraph
+{
+private:
+	std::map<std::string, TechResearchLinks> _research;
+	std::map<std::string, TechItemLinks> _items;
+	std::map<std::string, std::string> _craftProducedBy;
+	std::vector<TechEdge> _edges;
+	static const TechResearchLinks _emptyResearchLinks;
+	static const TechItemLinks _emptyItemLinks;
+	static const std::string _emptyName;
+public:
+	/// Builds the graph from the loaded rules.
+	void build(const Mod *mod);
+	/// Gets the rules that refer to a research topic.
+	const TechResearchLinks &getResearchLinks(const std::string &research) const;
+	/// Gets the rules that refer to an item.
+	const TechItemLinks &getItemLinks(const std::string &item) const;
+	/// Gets the first manufacture project producing a craft.
+	const std::string &getCraftProducedBy(const std::string &craft) const;
+	/// Gets all the relations.
+	const std::vector<TechEdge> &getEdges() const { return _edges; }
+	/// Writes the graph in Graphviz DOT format.
+	void exportDot(std::ostream &out) const;
+	/// Writes the graph as JSON.
+	void exportJson(std::ostream &out) const;
+	/// Writes the graph to a file, as JSON if the name ends with .json, otherwise as DOT.
+	bool exportFile(const std::string &filename) const;
+};
+
+}
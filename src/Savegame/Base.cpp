@@ -19,6 +19,7 @@
 #include "Base.h"
 #include "../fmath.h"
 #include <stack>
+#include <cassert>
 #include <algorithm>
 #include <functional>
 #include "BaseFacility.h"
@@ -118,6 +119,7 @@ void Base::load(const YAML::YamlNodeReader& reader, SavedGame *save, bool newGam
 				BaseFacility* f = new BaseFacility(_mod->getBaseFacility(type), this);
 				f->load(facilityReader);
 				_facilities.push_back(f);
+				invalidateCapacities();
 			}
 			else
 			{
@@ -422,12 +424,60 @@ int Base::getMarker() const
 }
 
 /**
- * Returns the list of facilities in the base.
- * @return Pointer to the facility list.
+ * Sums up the capacities provided by all
+ * the finished facilities in the base.
+ * @return Base capacities.
  */
-std::vector<BaseFacility*> *Base::getFacilities()
+BaseCapacities Base::calculateCapacities() const
 {
-	return &_facilities;
+	BaseCapacities total;
+	int minRadarRange = _mod->getShortRadarRange();
+	for (const auto* fac : _facilities)
+	{
+		if (fac->getBuildTime() != 0)
+		{
+			continue;
+		}
+		const RuleBaseFacility *rules = fac->getRules();
+		total.quarters += rules->getPersonnel();
+		total.stores += rules->getStorage();
+		total.laboratories += rules->getLaboratories();
+		total.workshops += rules->getWorkshops();
+		total.hangars += rules->getCrafts();
+		total.psiLabs += rules->getPsiLaboratories();
+		total.training += rules->getTrainingFacilities();
+		total.defense += rules->getDefenseValue();
+		if (rules->getRadarRange() > 0 && rules->getRadarRange() <= minRadarRange)
+		{
+			total.shortRangeDetection++;
+		}
+		if (rules->getRadarRange() > minRadarRange)
+		{
+			total.longRangeDetection++;
+		}
+		if (rules->getAliens() != 0)
+		{
+			total.containment[rules->getPrisonType()] += rules->getAliens();
+		}
+	}
+	return total;
+}
+
+/**
+ * Returns the capacities of the finished facilities,
+ * recalculating them only after the facilities changed.
+ * @return Base capacities.
+ */
+const BaseCapacities &Base::getCapacities() const
+{
+	if (!_capacitiesValid)
+	{
+		_capacities = calculateCapacities();
+		_capacitiesValid = true;
+	}
+	// somebody changed the facilities without invalidating the cache
+	assert(_capacities == calculateCapacities());
+	return _capacities;
 }
 
 /**
@@ -495,20 +545,33 @@ void Base::setEngineers(int engineers)
  */
 UfoDetection Base::detect(const Ufo *target, const SavedGame *save, bool alreadyTracked) const
 {
-	int distance = XcomDistance(getDistance(target));
+	std::vector<const BaseFacility*> radars;
+	getRadarFacilities(radars);
+	return detect(target, save, alreadyTracked, getDistance(target), radars);
+}
+
+/**
+ * Returns if a certain target is covered by the given radar
+ * facilities of this base. Used by batched detection, which
+ * gathers the facilities and distances once per pass.
+ * @param target Pointer to target to compare.
+ * @param alreadyTracked Was ufo already detected, `true` mean we track it without probability.
+ * @param distance Great circle distance to the target, in radians.
+ * @param radars Facilities returned by getRadarFacilities().
+ * @return 0 - not detected, 1 - detected by conventional radar, 2 - detected by hyper-wave decoder.
+ */
+UfoDetection Base::detect(const Ufo *target, const SavedGame *save, bool alreadyTracked, double distance, const std::vector<const BaseFacility*> &radars) const
+{
+	int xcomDistance = XcomDistance(distance);
 	bool hyperwave = false;
 	int hyperwave_max_range = 0;
 	int hyperwave_chance = 0;
 	int radar_max_range = 0;
 	int radar_chance = 0;
 
-	for (const auto* fac : _facilities)
+	for (const auto* fac : radars)
 	{
-		if (fac->getBuildTime() != 0)
-		{
-			continue;
-		}
-		if (fac->getRules()->getRadarRange() >= distance)
+		if (fac->getRules()->getRadarRange() >= xcomDistance)
 		{
 			int radarChance = fac->getRules()->getRadarChance();
 			if (fac->getRules()->isHyperwave())
@@ -565,13 +628,35 @@ UfoDetection Base::detect(const Ufo *target, const SavedGame *save, bool already
 	}
 
 	ModScript::DetectUfoFromBase::Output args { detectionType, detectionChance, };
-	ModScript::DetectUfoFromBase::Worker work { target, save, distance, alreadyTracked, radar_chance, radar_max_range, hyperwave_chance, hyperwave_max_range, };
+	ModScript::DetectUfoFromBase::Worker work { target, save, xcomDistance, alreadyTracked, radar_chance, radar_max_range, hyperwave_chance, hyperwave_max_range, };
 
 	work.execute(target->getRules()->getScript<ModScript::DetectUfoFromBase>(), args);
 
 	return RNG::percent(args.getSecond()) ? (UfoDetection)args.getFirst() : DETECTION_NONE;
 }
 
+/**
+ * Gathers the finished facilities that can affect radar detection,
+ * skipping the ones with no range, no chance and no hyper-wave decoder.
+ * @param radars Vector to fill, in facility order.
+ */
+void Base::getRadarFacilities(std::vector<const BaseFacility*> &radars) const
+{
+	radars.clear();
+	for (const auto* fac : _facilities)
+	{
+		if (fac->getBuildTime() != 0)
+		{
+			continue;
+		}
+		const RuleBaseFacility *rule = fac->getRules();
+		if (rule->getRadarRange() > 0 || rule->getRadarChance() != 0 || rule->isHyperwave())
+		{
+			radars.push_back(fac);
+		}
+	}
+}
+
 /**
  * Returns the amount of soldiers contained
  * in the base without any assignments.
@@ -809,15 +894,7 @@ int Base::getUsedQuarters() const
  */
 int Base::getAvailableQuarters() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getPersonnel();
-		}
-	}
-	return total;
+	return getCapacities().quarters;
 }
 
 /**
@@ -880,15 +957,7 @@ bool Base::storesOverfullCritical() const
  */
 int Base::getAvailableStores() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getStorage();
-		}
-	}
-	return total;
+	return getCapacities().stores;
 }
 
 /**
@@ -913,15 +982,7 @@ int Base::getUsedLaboratories() const
  */
 int Base::getAvailableLaboratories() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getLaboratories();
-		}
-	}
-	return total;
+	return getCapacities().laboratories;
 }
 
 /**
@@ -952,15 +1013,7 @@ int Base::getUsedWorkshops() const
  */
 int Base::getAvailableWorkshops() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getWorkshops();
-		}
-	}
-	return total;
+	return getCapacities().workshops;
 }
 
 /**
@@ -996,15 +1049,7 @@ int Base::getUsedHangars() const
  */
 int Base::getAvailableHangars() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getCrafts();
-		}
-	}
-	return total;
+	return getCapacities().hangars;
 }
 
 /**
@@ -1078,15 +1123,7 @@ int Base::getAllocatedEngineers() const
  */
 int Base::getDefenseValue() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getDefenseValue();
-		}
-	}
-	return total;
+	return getCapacities().defense;
 }
 
 /**
@@ -1096,18 +1133,7 @@ int Base::getDefenseValue() const
  */
 int Base::getShortRangeDetection() const
 {
-	int total = 0;
-	int minRadarRange = _mod->getShortRadarRange();
-
-	if (minRadarRange == 0) return 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getRules()->getRadarRange() > 0 && fac->getRules()->getRadarRange() <= minRadarRange && fac->getBuildTime() == 0)
-		{
-			total++;
-		}
-	}
-	return total;
+	return getCapacities().shortRangeDetection;
 }
 
 /**
@@ -1117,17 +1143,7 @@ int Base::getShortRangeDetection() const
  */
 int Base::getLongRangeDetection() const
 {
-	int total = 0;
-	int minRadarRange = _mod->getShortRadarRange();
-
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getRules()->getRadarRange() > minRadarRange && fac->getBuildTime() == 0)
-		{
-			total++;
-		}
-	}
-	return total;
+	return getCapacities().longRangeDetection;
 }
 
 /**
@@ -1360,15 +1376,7 @@ const std::vector<Production *> & Base::getProductions() const
  */
 int Base::getAvailablePsiLabs() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getPsiLaboratories();
-		}
-	}
-	return total;
+	return getCapacities().psiLabs;
 }
 
 /**
@@ -1407,15 +1415,7 @@ int Base::getUsedPsiLabs() const
  */
 int Base::getAvailableTraining() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getTrainingFacilities();
-		}
-	}
-	return total;
+	return getCapacities().training;
 }
 
 /**
@@ -1500,15 +1500,9 @@ int Base::getUsedContainment(int prisonType, bool onlyExternal) const
  */
 int Base::getAvailableContainment(int prisonType) const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0 && fac->getRules()->getPrisonType() == prisonType)
-		{
-			total += fac->getRules()->getAliens();
-		}
-	}
-	return total;
+	const auto &containment = getCapacities().containment;
+	auto it = containment.find(prisonType);
+	return it != containment.end() ? it->second : 0;
 }
 
 /**
@@ -1734,6 +1728,7 @@ int Base::damageFacility(BaseFacility *toBeDamaged)
 		fac->setY(toBeDamaged->getY());
 		fac->setBuildTime(0);
 		_facilities.push_back(fac);
+		invalidateCapacities();
 
 		// move the craft from the original hangar to the damaged hangar
 		if (fac->getRules()->getCrafts() > 0)
@@ -1753,6 +1748,7 @@ int Base::damageFacility(BaseFacility *toBeDamaged)
 				fac->setY(toBeDamaged->getY() + y);
 				fac->setBuildTime(0);
 				_facilities.push_back(fac);
+				invalidateCapacities();
 			}
 		}
 	}
@@ -2060,6 +2056,7 @@ void Base::destroyFacility(BASEFACILITIESITERATOR facility)
 	_destroyedFacilitiesCache[(*facility)->getRules()] += 1;
 	delete *facility;
 	_facilities.erase(facility);
+	invalidateCapacities();
 }
 
 /**
@@ -101,6 +101,24 @@ struct BaseSumDailyRecovery
 	float SickBayAbsoluteBonus = 0.0f;
 };
 
+/**
+ * Capacities provided by the finished facilities of a base.
+ */
+struct BaseCapacities
+{
+	int quarters = 0, stores = 0, laboratories = 0, workshops = 0, hangars = 0, psiLabs = 0, training = 0;
+	int defense = 0, shortRangeDetection = 0, longRangeDetection = 0;
+	/// Alien containment space by prison type.
+	std::map<int, int> containment;
+
+	bool operator==(const BaseCapacities& other) const
+	{
+		return quarters == other.quarters && stores == other.stores && laboratories == other.laboratories && workshops == other.workshops
+			&& hangars == other.hangars && psiLabs == other.psiLabs && training == other.training && defense == other.defense
+			&& shortRangeDetection == other.shortRangeDetection && longRangeDetection == other.longRangeDetection && containment == other.containment;
+	}
+};
+
 /**
  * Represents a player base on the globe.
  * Bases can contain facilities, personnel, crafts and equipment.
@@ -128,6 +146,13 @@ private:
 	std::map<const RuleBaseFacility*, int> _destroyedFacilitiesCache;
 	RuleBaseFacilityFunctions _provideBaseFunc = 0;
 	RuleBaseFacilityFunctions _forbiddenBaseFunc = 0;
+	mutable BaseCapacities _capacities;
+	mutable bool _capacitiesValid = false;
+
+	/// Sums up the capacities of all finished facilities.
+	BaseCapacities calculateCapacities() const;
+	/// Gets the cached facility capacities.
+	const BaseCapacities &getCapacities() const;
 
 	using Target::load;
 public:
@@ -150,8 +175,12 @@ public:
 	std::string getName(Language *lang = 0) const override;
 	/// Gets the base's marker sprite.
 	int getMarker() const override;
+	/// Gets the base's facilities, call invalidateCapacities() after changing them.
+	std::vector<BaseFacility*> *getFacilities() { return &_facilities; }
 	/// Gets the base's facilities.
-	std::vector<BaseFacility*> *getFacilities();
+	const std::vector<BaseFacility*> *getFacilities() const { return &_facilities; }
+	/// Marks the cached facility capacities as out of date.
+	void invalidateCapacities() { _capacitiesValid = false; }
 	/// Gets the base's soldiers.
 	std::vector<Soldier*> *getSoldiers();
 	/// Pre-calculates soldier stats with various bonuses.
@@ -178,6 +207,10 @@ public:
 	void setEngineers(int engineers);
 	/// Checks if a target is detected by the base's radar.
 	UfoDetection detect(const Ufo *target, const SavedGame *save, bool alreadyTracked) const;
+	/// Checks if a target at a known distance is detected by the given radar facilities.
+	UfoDetection detect(const Ufo *target, const SavedGame *save, bool alreadyTracked, double distance, const std::vector<const BaseFacility*> &radars) const;
+	/// Gets the finished facilities that take part in radar detection.
+	void getRadarFacilities(std::vector<const BaseFacility*> &radars) const;
 	/// Gets the base's available soldiers.
 	int getAvailableSoldiers(bool checkCombatReadiness = false, bool includeWounded = false) const;
 	/// Gets the base's total soldiers.
@@ -176,6 +176,7 @@ int BaseFacility::getAdjustedBuildTime() const
 void BaseFacility::setBuildTime(int time)
 {
 	_buildTime = time;
+	_base->invalidateCapacities();
 }
 
 /**
@@ -186,6 +187,7 @@ void BaseFacility::build()
 	_buildTime--;
 	if (_buildTime == 0)
 		_hadPreviousFacility = false;
+	_base->invalidateCapacities();
 }
 
 /**
@@ -1174,7 +1174,19 @@ void Craft::checkup()
  */
 UfoDetection Craft::detect(const Ufo *target, const SavedGame *save, bool alreadyTracked) const
 {
-	int distance = XcomDistance(getDistance(target));
+	return detect(target, save, alreadyTracked, getDistance(target));
+}
+
+/**
+ * Returns if a certain target at a known distance is detected
+ * by the craft's radar, taking in account the range and chance.
+ * @param target Pointer to target to compare.
+ * @param distanceRadian Great circle distance to the target, in radians.
+ * @return True if it's detected, False otherwise.
+ */
+UfoDetection Craft::detect(const Ufo *target, const SavedGame *save, bool alreadyTracked, double distanceRadian) const
+{
+	int distance = XcomDistance(distanceRadian);
 
 	int detectionChance = 0;
 	UfoDetection detectionType = DETECTION_NONE;
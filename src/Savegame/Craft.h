@@ -252,10 +252,14 @@ public:
 	void evacuateCrew(const Mod *mod);
 	/// Checks if a target is detected by the craft's radar.
 	UfoDetection detect(const Ufo *target, const SavedGame *save, bool alreadyTracked) const;
+	/// Checks if a target at a known distance is detected by the craft's radar.
+	UfoDetection detect(const Ufo *target, const SavedGame *save, bool alreadyTracked, double distance) const;
 	/// Handles craft logic.
 	bool think();
 	/// Is the craft about to take off?
 	bool isTakingOff() const;
+	/// Is the craft still counting down to take off?
+	bool hasTakeoffPending() const { return _takeoff != 0; }
 	/// Does a craft full checkup.
 	void checkup();
 	/// Consumes the craft's fuel.
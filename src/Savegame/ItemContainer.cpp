@@ -46,6 +46,7 @@ void ItemContainer::load(const YAML::YamlNodeReader& reader, const Mod* mod)
 	if (!reader || !reader.isMap())
 		return;
 	_qty.clear();
+	_totalsValid = false;
 	for (const auto& item : reader.children())
 	{
 		std::string name = item.readKey<std::string>();
@@ -88,6 +89,7 @@ void ItemContainer::addItem(const RuleItem* item, int qty)
 	if (item)
 	{
 		_qty[item] += qty;
+		_totalsValid = false;
 	}
 }
 
@@ -116,6 +118,7 @@ void ItemContainer::removeItem(const std::string &id, int qty)
 	{
 		_qty.erase(it);
 	}
+	_totalsValid = false;
 }
 
 /**
@@ -141,6 +144,7 @@ void ItemContainer::removeItem(const RuleItem* item, int qty)
 		{
 			_qty.erase(it);
 		}
+		_totalsValid = false;
 	}
 }
 
@@ -198,12 +202,8 @@ int ItemContainer::getItem(const RuleItem* item) const
  */
 int ItemContainer::getTotalQuantity() const
 {
-	int total = 0;
-	for (const auto& pair : _qty)
-	{
-		total += pair.second;
-	}
-	return total;
+	updateTotals();
+	return _totalQuantity;
 }
 
 /**
@@ -212,12 +212,30 @@ int ItemContainer::getTotalQuantity() const
  */
 double ItemContainer::getTotalSize() const
 {
-	double total = 0;
+	updateTotals();
+	return _totalSize;
+}
+
+/**
+ * Sums up the quantity and size of the items, only
+ * if the contents changed since the last time.
+ * The sums are always redone from scratch in the same
+ * order, so they are exactly what a fresh scan returns.
+ */
+void ItemContainer::updateTotals() const
+{
+	if (_totalsValid)
+	{
+		return;
+	}
+	_totalQuantity = 0;
+	_totalSize = 0;
 	for (const auto& pair : _qty)
 	{
-		total += pair.first->getSize() * pair.second;
+		_totalQuantity += pair.second;
+		_totalSize += pair.first->getSize() * pair.second;
 	}
-	return total;
+	_totalsValid = true;
 }
 
 /**
@@ -36,6 +36,12 @@ class ItemContainer
 {
 private:
 	std::map<const RuleItem*, int> _qty;
+	mutable int _totalQuantity = 0;
+	mutable double _totalSize = 0.0;
+	mutable bool _totalsValid = true;
+
+	/// Recalculates the totals if the contents changed since.
+	void updateTotals() const;
 public:
 	/// Creates an empty item container.
 	ItemContainer();
@@ -64,7 +70,7 @@ public:
 	/// Check if have any item
 	bool empty() const { return _qty.empty(); }
 	/// Clear all content.
-	void clear() { _qty.clear(); }
+	void clear() { _qty.clear(); _totalsValid = false; }
 	/// Gets all the items in the container.
 	const std::map<const RuleItem*, int> *getContents() const;
 };
@@ -27,7 +27,7 @@ namespace OpenXcom
 /**
  * Initializes a moving target with blank coordinates.
  */
-MovingTarget::MovingTarget() : Target(), _dest(0), _speedLon(0.0), _speedLat(0.0), _speedRadian(0.0), _meetPointLon(0.0), _meetPointLat(0.0), _speed(0), _meetCalculated(false)
+MovingTarget::MovingTarget() : Target(), _dest(0), _speedLon(0.0), _speedLat(0.0), _speedRadian(0.0), _meetPointLon(0.0), _meetPointLat(0.0), _meetPointDistance(0.0), _speed(0), _meetCalculated(false)
 {
 }
 
@@ -161,16 +161,28 @@ void MovingTarget::setSpeed(int speed)
 /**
  * Calculates the speed vector based on the
  * great circle distance to destination and
- * current raw speed.
+ * current raw speed. The distance to the meeting
+ * point shares the same trig terms, so it's kept
+ * for move() instead of being recomputed there.
  */
 void MovingTarget::calculateSpeed()
 {
 	calculateMeetPoint();
 	if (_dest != 0)
 	{
+		const double cosLat = cos(_lat), sinLat = sin(_lat);
+		const double cosMeetLat = cos(_meetPointLat), sinMeetLat = sin(_meetPointLat);
+		const double cosDeltaLon = cos(_meetPointLon - _lon);
+
+		// same formula as Target::getDistance()
+		if (AreSame(_meetPointLon, _lon) && AreSame(_meetPointLat, _lat))
+			_meetPointDistance = 0.0;
+		else
+			_meetPointDistance = acos(cosLat * cosMeetLat * cosDeltaLon + sinLat * sinMeetLat);
+
 		double dLon, dLat, length;
-		dLon = sin(_meetPointLon - _lon) * cos(_meetPointLat);
-		dLat = cos(_lat) * sin(_meetPointLat) - sin(_lat) * cos(_meetPointLat) * cos(_meetPointLon - _lon);
+		dLon = sin(_meetPointLon - _lon) * cosMeetLat;
+		dLat = cosLat * sinMeetLat - sinLat * cosMeetLat * cosDeltaLon;
 		length = sqrt(dLon * dLon + dLat * dLat);
 		_speedLat = dLat / length * _speedRadian;
 		_speedLon = dLon / length * _speedRadian / cos(_lat + _speedLat);
@@ -186,6 +198,7 @@ void MovingTarget::calculateSpeed()
 	{
 		_speedLon = 0;
 		_speedLat = 0;
+		_meetPointDistance = 0.0;
 	}
 }
 
@@ -210,7 +223,7 @@ void MovingTarget::move()
 	calculateSpeed();
 	if (_dest != 0)
 	{
-		if (getDistance(_meetPointLon, _meetPointLat) > _speedRadian)
+		if (_meetPointDistance > _speedRadian)
 		{
 			setLongitude(_lon + _speedLon);
 			setLatitude(_lat + _speedLat);
@@ -33,7 +33,7 @@ protected:
 
 	Target *_dest;
 	double _speedLon, _speedLat, _speedRadian;
-	double _meetPointLon, _meetPointLat;
+	double _meetPointLon, _meetPointLat, _meetPointDistance;
 	int _speed;
 	bool _meetCalculated;
 
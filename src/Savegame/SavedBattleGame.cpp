@@ -40,6 +40,7 @@
 #include "../Engine/Sound.h"
 #include "../Mod/RuleInventory.h"
 #include "../Battlescape/AIModule.h"
+#include "../Battlescape/AIKnowledge.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Options.h"
 #include "../Engine/Logger.h"
@@ -64,7 +65,7 @@ namespace OpenXcom
 SavedBattleGame::SavedBattleGame(Mod *rule, Language *lang, bool isPreview) :
 	_isPreview(isPreview), _craftPos(), _craftZ(0), _craftForPreview(nullptr),
 	_battleState(0), _rule(rule), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0), _undoUnit(nullptr),
-	_lastSelectedUnit(0), _pathfinding(0), _tileEngine(0),
+	_lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _aiKnowledge(0),
 	_reinforcementsItemLevel(0), _startingCondition(nullptr), _enviroEffects(nullptr), _ecEnabledFriendly(false), _ecEnabledHostile(false), _ecEnabledNeutral(false),
 	_globalShade(0), _side(FACTION_PLAYER), _turn(0), _bughuntMinTurn(20), _animFrame(0), _nameDisplay(false),
 	_debugMode(false), _bughuntMode(false), _aborted(false), _itemId(0),
@@ -122,6 +123,7 @@ SavedBattleGame::~SavedBattleGame()
 	}
 	delete _pathfinding;
 	delete _tileEngine;
+	delete _aiKnowledge;
 	delete _baseItems;
 	delete _hitLog;
 }
@@ -636,6 +638,7 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	}
 
 	_nodes.clear();
+	_patrolNodesValid = false;
 
 	if (resetTerrain)
 	{
@@ -664,9 +667,11 @@ void SavedBattleGame::initUtilities(Mod *mod, bool craftInventory)
 {
 	delete _pathfinding;
 	delete _tileEngine;
+	delete _aiKnowledge;
 	_baseCraftInventory = craftInventory;
 	_pathfinding = craftInventory ? nullptr : new Pathfinding(this);
 	_tileEngine = new TileEngine(this, mod);
+	_aiKnowledge = craftInventory ? nullptr : new AIKnowledge(this);
 }
 
 /**
@@ -1080,6 +1085,15 @@ TileEngine *SavedBattleGame::getTileEngine() const
 	return _tileEngine;
 }
 
+/**
+ * Gets what the AI of each faction knows about the units.
+ * @return Pointer to the AI knowledge, null in the craft pre-equip phase.
+ */
+AIKnowledge *SavedBattleGame::getAIKnowledge() const
+{
+	return _aiKnowledge;
+}
+
 /**
  * Gets the array of mapblocks.
  * @return Pointer to the array of mapblocks.
@@ -1607,6 +1621,12 @@ void SavedBattleGame::endTurn()
 	//scripts update
 	newTurnUpdateScripts();
 
+	// the AI builds its knowledge from scratch each turn
+	if (_aiKnowledge)
+	{
+		_aiKnowledge->reset();
+	}
+
 	//fov check will be done by `BattlescapeGame::endTurn`
 
 	if (_side != FACTION_PLAYER)
@@ -2291,6 +2311,40 @@ Node *SavedBattleGame::getSpawnNode(int nodeRank, BattleUnit *unit)
 	return compliantNodes[n];
 }
 
+/**
+ * Gets the nodes a unit may ever patrol to, in node order: the ones that
+ * aren't dummies, fit the unit's size and movement type and aren't on
+ * the map edge. Only the checks that change during the battle are left
+ * to getPatrolNode. The lists are rebuilt when nodes are added.
+ * @param unit Pointer to the unit.
+ * @return List of nodes.
+ */
+const std::vector<Node*> &SavedBattleGame::getPatrolCandidates(const BattleUnit *unit)
+{
+	if (!_patrolNodesValid || _patrolNodesCount != _nodes.size())
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			bool small = (i & 1) != 0;
+			bool flying = (i & 2) != 0;
+			_patrolNodes[i].clear();
+			for (auto* node : _nodes)
+			{
+				if (!node->isDummy()
+					&& (!(node->getType() & Node::TYPE_SMALL) || small)
+					&& (!(node->getType() & Node::TYPE_FLYING) || flying)
+					&& node->getPosition().x > 0 && node->getPosition().y > 0)
+				{
+					_patrolNodes[i].push_back(node);
+				}
+			}
+		}
+		_patrolNodesCount = _nodes.size();
+		_patrolNodesValid = true;
+	}
+	return _patrolNodes[(unit->isSmallUnit() ? 1 : 0) | (unit->getMovementType() == MT_FLY ? 2 : 0)];
+}
+
 /**
  * Finds a fitting node where a unit can patrol to.
  * @param scout Is the unit scouting?
@@ -2314,13 +2368,14 @@ Node *SavedBattleGame::getPatrolNode(bool scout, BattleUnit *unit, Node *fromNod
 	}
 
 	// scouts roam all over while all others shuffle around to adjacent nodes at most:
-	const int end = scout ? getNodes()->size() : fromNode->getNodeLinks()->size();
+	const std::vector<Node*> &candidates = getPatrolCandidates(unit);
+	const int end = scout ? candidates.size() : fromNode->getNodeLinks()->size();
 
 	for (int i = 0; i < end; ++i)
 	{
 		if (!scout && fromNode->getNodeLinks()->at(i) < 1) continue;
 
-		Node *n = getNodes()->at(scout ? i : fromNode->getNodeLinks()->at(i));
+		Node *n = scout ? candidates[i] : getNodes()->at(fromNode->getNodeLinks()->at(i));
 		if ( !n->isDummy()																				// don't consider dummy nodes.
 			&& (n->getFlags() > 0 || n->getRank() > 0 || scout)											// for non-scouts we find a node with a desirability above 0
 			&& (!(n->getType() & Node::TYPE_SMALL) || unit->isSmallUnit())								// the small unit bit is not set or the unit is small
@@ -37,6 +37,7 @@ class BattlescapeGame;
 class Position;
 class Pathfinding;
 class TileEngine;
+class AIKnowledge;
 class RuleStartingCondition;
 class RuleEnviroEffects;
 class BattleItem;
@@ -78,10 +79,15 @@ private:
 	std::vector<Tile> _tiles;
 	BattleUnit *_selectedUnit, *_undoUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
+	/// Nodes a scout may patrol to, by unit size and flying ability.
+	std::vector<Node*> _patrolNodes[4];
+	size_t _patrolNodesCount = 0;
+	bool _patrolNodesValid = false;
 	std::vector<BattleUnit*> _units;
 	std::vector<BattleItem*> _items, _deleted;
 	Pathfinding *_pathfinding;
 	TileEngine *_tileEngine;
+	AIKnowledge *_aiKnowledge;
 	std::string _missionType, _strTarget, _strCraftOrBase, _alienCustomDeploy, _alienCustomMission;
 	std::string _lastUsedMapScript;
 	int _alienItemLevel = 0;
@@ -134,6 +140,8 @@ private:
 	BattleUnit *selectPlayerUnit(int dir, bool checkReselect = false, bool setReselect = false, bool checkInventory = false);
 	/// Run newTurnUnit and newTurnItem scripts
 	void newTurnUpdateScripts();
+	/// Gets the nodes a unit may patrol to.
+	const std::vector<Node*> &getPatrolCandidates(const BattleUnit *unit);
 public:
 	/// Creates a new battle save, based on the current generic save.
 	SavedBattleGame(Mod *rule, Language *lang, bool isPreview = false);
@@ -388,6 +396,8 @@ public:
 	Pathfinding *getPathfinding() const;
 	/// Gets a pointer to the tile engine.
 	TileEngine *getTileEngine() const;
+	/// Gets a pointer to the shared AI knowledge.
+	AIKnowledge *getAIKnowledge() const;
 	/// Gets the playing side.
 	UnitFaction getSide() const;
 	/// Can unit use that weapon?
@@ -95,10 +95,30 @@ bool haveReserchVector(const std::vector<const RuleResearch*> &vec, const RuleRe
 	return find != vec.end() && *find == res;
 }
 
+bool researchNameLess(const RuleResearch *a, const RuleResearch *b)
+{
+	return a->getName() < b->getName();
+}
+
+void setDiscoveredBit(std::vector<bool> &mask, const RuleResearch *res)
+{
+	if (res->getIndex() < 0)
+	{
+		return;
+	}
+	size_t index = res->getIndex();
+	if (index >= mask.size())
+	{
+		mask.resize(index + 1, false);
+	}
+	mask[index] = true;
+}
+
+/// Looks up a name in a vector sorted with researchNameLess.
 bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::string &res)
 {
-	auto find = std::find_if(vec.begin(), vec.end(), [&](const RuleResearch* r){ return r->getName() == res; });
-	return find != vec.end();
+	auto find = std::lower_bound(vec.begin(), vec.end(), res, [](const RuleResearch* r, const std::string &name){ return r->getName() < name; });
+	return find != vec.end() && (*find)->getName() == res;
 }
 
 }
@@ -576,6 +596,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		}
 	}
 	sortReserchVector(_discovered);
+	updateDiscoveredIndex();
 
 	reader.tryRead("generatedEvents", _generatedEvents);
 	loadUfopediaRuleStatus(reader["ufopediaRuleStatus"]);
@@ -1486,6 +1507,7 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
 	if (r != _discovered.end())
 	{
 		_discovered.erase(r);
+		updateDiscoveredIndex();
 	}
 }
 
@@ -1500,6 +1522,41 @@ void SavedGame::makeAllResearchDiscovered(const Mod* mod)
 		_discovered.push_back(pair.second);
 	}
 	sortReserchVector(_discovered);
+	updateDiscoveredIndex();
+}
+
+/**
+ * Rebuilds the copy of the discovered research sorted
+ * by name, used by the isResearched() overloads that
+ * take names (binary search instead of comparing
+ * the name of every discovered topic), and the bitset
+ * used by the ones that take rules.
+ */
+void SavedGame::updateDiscoveredIndex()
+{
+	_discoveredByName = _discovered;
+	std::sort(_discoveredByName.begin(), _discoveredByName.end(), researchNameLess);
+	_discoveredMask.clear();
+	for (const auto* research : _discovered)
+	{
+		setDiscoveredBit(_discoveredMask, research);
+	}
+}
+
+/**
+ * Checks if a research is in the discovered list,
+ * using the bitset instead of searching the list.
+ * @param research Research rule.
+ * @return True if discovered.
+ */
+bool SavedGame::isDiscovered(const RuleResearch *research) const
+{
+	if (!research || research->getIndex() < 0)
+	{
+		return false;
+	}
+	size_t index = research->getIndex();
+	return index < _discoveredMask.size() && _discoveredMask[index];
 }
 
 /**
@@ -1535,8 +1592,10 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		{
 			if (!research->isRepeatable())
 			{
-				_discovered.push_back(currentQueueItem);
-				sortReserchVector(_discovered);
+				// both lists are already sorted, insert in place
+				_discovered.insert(std::lower_bound(_discovered.begin(), _discovered.end(), currentQueueItem, researchLess), currentQueueItem);
+				_discoveredByName.insert(std::lower_bound(_discoveredByName.begin(), _discoveredByName.end(), currentQueueItem, researchNameLess), currentQueueItem);
+				setDiscoveredBit(_discoveredMask, currentQueueItem);
 			}
 			if (!hasUndiscoveredProtectedUnlocks && !hasAnyUndiscoveredGetOneFrees)
 			{
@@ -1707,7 +1766,7 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 		}
 
 		// Remove the already researched topics from the list *UNLESS* they can still give you something more
-		if (isResearched(research->getName(), false))
+		if (isResearched(research, false))
 		{
 			if (hasUndiscoveredGetOneFree(research, true))
 			{
@@ -2096,7 +2155,7 @@ bool SavedGame::isResearched(const std::string &research, bool considerDebugMode
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return haveReserchVector(_discoveredByName, research);
 }
 
 bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMode) const
@@ -2106,7 +2165,7 @@ bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMod
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return isDiscovered(research);
 }
 
 bool SavedGame::isResearched(const std::vector<std::string> &research, bool considerDebugMode) const
@@ -2118,7 +2177,7 @@ bool SavedGame::isResearched(const std::vector<std::string> &research, bool cons
 
 	for (const auto& res : research)
 	{
-		if (!haveReserchVector(_discovered, res))
+		if (!haveReserchVector(_discoveredByName, res))
 		{
 			return false;
 		}
@@ -2151,7 +2210,7 @@ bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research,
 				continue;
 			}
 		}
-		if (!haveReserchVector(_discovered, res))
+		if (!isDiscovered(res))
 		{
 			return false;
 		}
@@ -3196,7 +3255,7 @@ bool SavedGame::canSpawnInstantEvent(const RuleEvent* eventRules)
 	}
 
 	bool interrupted = false;
-	if (!eventRules->getInterruptResearch().empty())
+	if (eventRules->getInterruptResearch())
 	{
 		if (isResearched(eventRules->getInterruptResearch(), false))
 		{
@@ -3254,14 +3313,10 @@ bool SavedGame::handleResearchUnlockedByMissions(const RuleResearch* research, c
 	// check and interrupt alien missions if necessary (based on unlocked research)
 	for (auto* am : _activeMissions)
 	{
-		const auto& interruptResearchName = am->getRules().getInterruptResearch();
-		if (!interruptResearchName.empty())
+		auto* interruptResearch = am->getRules().getInterruptResearch();
+		if (interruptResearch && std::find(researchVec.begin(), researchVec.end(), interruptResearch) != researchVec.end())
 		{
-			auto* interruptResearch = mod->getResearch(interruptResearchName, true);
-			if (std::find(researchVec.begin(), researchVec.end(), interruptResearch) != researchVec.end())
-			{
-				am->setInterrupted(true);
-			}
+			am->setInterrupted(true);
 		}
 	}
 
@@ -141,6 +141,8 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
+	std::vector<const RuleResearch*> _discoveredByName; // same as _discovered, sorted by name for string lookups
+	std::vector<bool> _discoveredMask; // same as _discovered, as a bitset over RuleResearch::getIndex()
 	std::map<std::string, int> _generatedEvents;
 	std::map<std::string, int> _ufopediaRuleStatus;
 	std::map<std::string, int> _manufactureRuleStatus;
@@ -177,6 +179,10 @@ private:
 	ScriptValues<SavedGame> _scriptValues;
 
 	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	/// Rebuilds the name index and the bitset of the discovered research.
+	void updateDiscoveredIndex();
+	/// Checks the discovered research bitset.
+	bool isDiscovered(const RuleResearch *research) const;
 public:
 	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
 	/// Creates a new saved game.
@@ -130,6 +130,7 @@ int main(int argc, char *argv[])
 	game->run();
 
 	bool startUpdate = game->getUpdateFlag();
+	int exitCode = game->getExitCode();
 
 	// Comment those two for faster exit.
 	delete game;
@@ -140,7 +141,7 @@ int main(int argc, char *argv[])
 		CrossPlatform::startUpdateProcess();
 	}
 
-	return EXIT_SUCCESS;
+	return exitCode;
 }
 
 namespace OpenXcom